@@ -1 +1,29 @@
+#pragma once
+
 #include <eosio/eosio.hpp>
+#include <string>
+
+using namespace eosio;
+
+/*
+   Shared by the contest contract (src/flair.cpp) & the payments contract (payments/src/flairpay.cpp). Tokens can
+   be held by either: with a payments contract set, it takes transfers in & forwards them as flair::fund, and the
+   contest contract sends every outbound transfer as flairpay::payout.
+*/
+
+/*
+   TABLE: options
+*/
+struct [[eosio::table]] option {
+   name id;
+   std::string value;
+   uint64_t primary_key() const { return id.value; }
+};
+
+typedef eosio::multi_index<name("options"), option> option_index;
+
+/*
+   The currency option is read by both contracts. It was always stored under the multichar literal 'currency',
+   which compilers cut down to its last four chars 'ency', so the raw key stays.
+*/
+constexpr name currencyOption = name(uint64_t(0x656e6379));
@@ -0,0 +1,87 @@
+#include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/print.hpp>
+#include <string>
+#include "../../include/flair.hpp"
+
+/*
+   Payments - holds the tokens of a flair contest contract, token notifications only load this contract
+*/
+class [[eosio::contract("flairpay")]] flairpay : public contract {
+  public:
+      using contract::contract;
+
+      /*
+         Set Contest Contract
+      */
+      [[eosio::action]]
+      void setcontests(name contests) {
+         require_auth( _self );
+         option_index options(_self, _self.value);
+         auto optionItr = options.find(name{"contests"}.value);
+         if (optionItr == options.end()) {
+            options.emplace(_self, [&](option& row) {
+               row.id = name{"contests"};
+               row.value = contests.to_string();
+            });
+         } else {
+            options.modify(optionItr, _self, [&](option& row) {
+               row.value = contests.to_string();
+            });
+         }
+      }
+
+      /*
+         On Payment - forwarded as is, the contest contract checks the memo
+      */
+      [[eosio::on_notify("eosio.token::transfer")]]
+      void deposit(name from, name to, asset quantity, std::string memo) {
+         if (to != _self) {
+            return;
+         }
+
+         name contests = contestsAccount();
+         check(bool(contests), "No contest contract set.");
+
+         // the currency is a setting of the contest contract
+         option_index contestOptions(contests, contests.value);
+         auto currencyItr = contestOptions.find(currencyOption.value);
+         std::string currency = currencyItr == contestOptions.end() ? "" : currencyItr->value;
+         if (quantity.symbol.code().to_string() != currency) {
+            print("Currency doesn't match: ", quantity.symbol.code().to_string(), " != ", currency);
+            return;
+         }
+
+         action{
+            permission_level{_self, name("active")},
+            contests,
+            name("fund"),
+            std::make_tuple(from, quantity, memo)
+         }.send();
+      }
+
+      /*
+         Payout - refunds, claims & prizes sent by the contest contract
+      */
+      [[eosio::action]]
+      void payout(name to, asset quantity, std::string memo) {
+         require_auth(contestsAccount());
+
+         action{
+            permission_level{_self, name("active")},
+            name("eosio.token"),
+            name("transfer"),
+            std::make_tuple(_self, to, quantity, memo)
+         }.send();
+      }
+
+   private:
+      name contestsAccount() {
+         option_index options(_self, _self.value);
+         auto optionItr = options.find(name{"contests"}.value);
+         if (optionItr == options.end()) {
+            return name();
+         }
+         return name(optionItr->value);
+      }
+};
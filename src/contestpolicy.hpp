@@ -0,0 +1,157 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include "safeint.hpp"
+
+/*
+   Contest Policies - the rules a level picks once, as types. flair selects the policy from the level rule or
+   contest row & instantiates activation, scheduling & settlement for it, so each runs straight-line code for
+   its level type. A new contest format adds a policy here & a case to its selector below.
+*/
+
+/*
+   Schedules - when voting opens, from the contest row
+*/
+
+// voting opens when the submission period ends
+struct plainSchedule {
+   template<typename contestT>
+   static uint64_t voteStart(const contestT& c) {
+      return (safeint{c.createdAt} + safeint{c.submissionPeriod}).amount;
+   }
+
+   template<typename contestT>
+   static void entryAdded(contestT& c, uint32_t now) {}
+
+   // true once voteStart no longer moves, for the evvotestart event
+   template<typename contestT>
+   static bool voteStartReached(const contestT& c) {
+      return c.participantCount == 1;
+   }
+};
+
+// voting opens at voteStartUTCHour on the first day it is reached after the contest was created
+struct hourSchedule {
+   template<typename contestT>
+   static uint64_t voteStart(const contestT& c) {
+      uint64_t hours = (c.createdAt / 3600) % 24;
+      uint64_t minutes = (c.createdAt / 60) % 60;
+      uint64_t seconds = c.createdAt % 60;
+      uint64_t hourStart = c.createdAt - (minutes * 60) - seconds;
+      if (hours < c.voteStartUTCHour) {
+         return hourStart + ((c.voteStartUTCHour - hours) * 3600);
+      }
+      return hourStart + ((24 + c.voteStartUTCHour - hours) * 3600);
+   }
+
+   template<typename contestT>
+   static void entryAdded(contestT& c, uint32_t now) {}
+
+   template<typename contestT>
+   static bool voteStartReached(const contestT& c) {
+      return c.participantCount == 1;
+   }
+};
+
+// voting opens once minParticipant entries are in, or when the submission period ends if that was earlier
+struct minimumSchedule {
+   static constexpr uint64_t notScheduled = 253370764800; // Jan 1, 9999 @ 12:00:00 AM
+
+   template<typename contestT>
+   static uint64_t voteStart(const contestT& c) {
+      if (c.lastEntryAddedAt > 0) {
+         return c.lastEntryAddedAt;
+      }
+      if (c.minParticipant > c.participantCount) {
+         return notScheduled;
+      }
+      return (safeint{c.createdAt} + safeint{c.submissionPeriod}).amount;
+   }
+
+   // the entry that reaches the minimum after the submission period starts the vote
+   template<typename contestT>
+   static void entryAdded(contestT& c, uint32_t now) {
+      if (c.minParticipant == c.participantCount && now > c.createdAt + c.submissionPeriod) {
+         c.lastEntryAddedAt = now;
+      }
+   }
+
+   template<typename contestT>
+   static bool voteStartReached(const contestT& c) {
+      return c.participantCount == c.minParticipant;
+   }
+};
+
+/*
+   Payouts - where the prize pool comes from
+*/
+
+// prizes are split from the entry payments, less the level fee
+struct entryPoolPayout {
+   static constexpr bool usesPrizeFund = false;
+
+   static eosio::asset prizePool(const eosio::asset& entryPayments, uint64_t fixedPrize) {
+      return entryPayments;
+   }
+
+   static eosio::asset fee(const eosio::asset& prizePool, uint16_t feePerMille) {
+      return prizePool * feePerMille / 1000;
+   }
+};
+
+// a fixed prize is reserved from the prize fund when the contest opens, no fee is taken
+struct prizeFundPayout {
+   static constexpr bool usesPrizeFund = true;
+
+   static eosio::asset prizePool(const eosio::asset& entryPayments, uint64_t fixedPrize) {
+      return eosio::asset(fixedPrize, entryPayments.symbol);
+   }
+
+   static eosio::asset fee(const eosio::asset& prizePool, uint16_t feePerMille) {
+      return eosio::asset(0, prizePool.symbol);
+   }
+};
+
+/*
+   Entry Pricing - whether an entry has to be paid before it joins a contest
+*/
+
+struct freeEntry {
+   static constexpr bool activatesOnEnter = true;
+};
+
+struct paidEntry {
+   static constexpr bool activatesOnEnter = false;
+};
+
+/*
+   Selectors - pick the policy once & call fn with it. Levels pick from their levelrules flags, contests from their
+   own row, which copies the level's fields when it opens.
+*/
+
+template<typename fnT>
+auto withPayout(bool fixedPrize, fnT&& fn) {
+   if (fixedPrize) {
+      return fn(prizeFundPayout{});
+   }
+   return fn(entryPoolPayout{});
+}
+
+template<typename contestT, typename fnT>
+auto withSchedule(const contestT& c, fnT&& fn) {
+   if (c.minParticipant > 0) {
+      return fn(minimumSchedule{});
+   } else if (c.voteStartUTCHour > 0) {
+      return fn(hourSchedule{});
+   }
+   return fn(plainSchedule{});
+}
+
+template<typename fnT>
+auto withPricing(bool free, fnT&& fn) {
+   if (free) {
+      return fn(freeEntry{});
+   }
+   return fn(paidEntry{});
+}
@@ -4,11 +4,12 @@
 #include <eosio/print.hpp>
 #include <eosio/crypto.hpp>
 #include <eosio/system.hpp>
+#include <eosio/binary_extension.hpp>
 #include <string>
-#include <map>
+#include <algorithm>
 #include "safeint.hpp"
-
-using namespace eosio;
+#include "contestpolicy.hpp"
+#include "../include/flair.hpp"
 
 class [[eosio::contract("flair")]] flair : public contract {
   public:
@@ -59,15 +60,15 @@ class [[eosio::contract("flair")]] flair : public contract {
          CREATE LEVEL
       */
       struct createlvlargs {
-         name id;
-         name categoryId;
+         eosio::name id;
+         eosio::name categoryId;
          std::string name;
          uint32_t price;
          uint32_t participantLimit;
          uint32_t submissionPeriod;
          uint32_t votePeriod;
          uint32_t fee;
-         std::list<uint32_t> prizes;
+         std::vector<uint32_t> prizes;
          uint32_t fixedPrize;
          uint32_t allowedSimultaneousContests;
          uint32_t voteStartUTCHour;
@@ -78,9 +79,14 @@ class [[eosio::contract("flair")]] flair : public contract {
       void createlevel(createlvlargs params) {
          require_auth( _self );
 
+         // contests & entries are scoped by category, maintenance only visits the categories table
+         category_index categories( _self, _self.value );
+         check(categories.find(params.categoryId.value) != categories.end(), "Category not found");
+
          level_index levels( _self, _self.value );
 
-         levels.emplace(_self, [&](level& row) {
+         auto levelItr = levels.emplace(_self, [&](level& row) {
+            upgradeRow(row);
             row.id = params.id;
             row.categoryId = params.categoryId;
             row.name = params.name;
@@ -96,6 +102,7 @@ class [[eosio::contract("flair")]] flair : public contract {
             row.voteStartUTCHour = params.voteStartUTCHour;
             row.minParticipant = params.minParticipant;
          });
+         syncLevelRule(*levelItr);
       }
 
       /*
@@ -109,7 +116,7 @@ class [[eosio::contract("flair")]] flair : public contract {
          uint32_t submissionPeriod;
          uint32_t votePeriod;
          uint32_t fee;
-         std::list<uint32_t> prizes;
+         std::vector<uint32_t> prizes;
          uint32_t fixedPrize;
          uint32_t allowedSimultaneousContests;
          uint32_t voteStartUTCHour;
@@ -123,9 +130,14 @@ class [[eosio::contract("flair")]] flair : public contract {
          level_index levels( _self, _self.value );
 
          auto iterator = levels.find(id.value);
+         check(iterator != levels.end(), "Level not found");
          check(data.minParticipant == 0 || data.voteStartUTCHour == 0, "cannot use both voteStartUTCHour & minParticipant");
 
+         category_index categories( _self, _self.value );
+         check(categories.find(iterator->categoryId.value) != categories.end(), "Category not found");
+
          levels.modify(iterator, _self, [&](level& row) {
+            upgradeRow(row);
             row.id = id;
             row.name = data.name;
             row.archived = data.archived;
@@ -140,6 +152,7 @@ class [[eosio::contract("flair")]] flair : public contract {
             row.voteStartUTCHour = data.voteStartUTCHour;
             row.minParticipant = data.minParticipant;
          });
+         syncLevelRule(*iterator);
       }
 
       /*
@@ -153,13 +166,20 @@ class [[eosio::contract("flair")]] flair : public contract {
       void editcntst(name id,  editcntstargs data) {
          require_auth( _self );
 
-         contest_index contests( _self, _self.value );
-
-         auto iterator = contests.find(id.value);
+         for (auto scope : contestScopes()) {
+            contest_index contests(_self, scope);
+            auto iterator = contests.find(id.value);
+            if (iterator == contests.end()) {
+               continue;
+            }
 
-         contests.modify(iterator, _self, [&](contest& row) {
-            row.minParticipant = data.minParticipant;
-         });
+            contests.modify(iterator, _self, [&](contest& row) {
+               upgradeRow(row);
+               row.minParticipant = data.minParticipant;
+            });
+            return;
+         }
+         check(false, "Contest not found");
       }
 
       /*
@@ -181,21 +201,108 @@ class [[eosio::contract("flair")]] flair : public contract {
 
          check(checkusername(params.username), "Invalid Username");
          checkUsernameExists(params.username);
-         checkAndSanitizeLink(params.link);
-         checkAndSanitizeBio(params.bio);
+         checkAccountFree(params.account, params.id);
+         bool hashText = get_option(name{"textmode"}) == "hash";
 
          profile_index profiles( _self, _self.value );
          checksum256 usernameHash = hashUsername(params.username);
          profiles.emplace(_self, [&](profile& row) {
+            upgradeRow(row);
             row.id = params.id;
             row.username = params.username;
             row.usernameHash = usernameHash;
             row.imgHash = params.imgHash;
             row.account = params.account;
             row.active = params.active;
-            row.link = params.link;
-            row.bio = params.bio;
+            setProfileText(row, params.link, params.bio, hashText);
          });
+
+         syncProfileAuth(params.id, params.account, params.active);
+      }
+
+      /*
+         ADD PROFILES (bulk import)
+      */
+      [[eosio::action]]
+      void addprofiles(std::vector<addprofargs> params) {
+         require_auth( _self );
+         check(params.size() > 0, "No profiles to import");
+
+         // every username & look-alike variant hashed once, sorted so clashes sit next to each other
+         std::vector<checksum256> usernameHashes;
+         std::vector<std::pair<checksum256, uint32_t>> variantHashes;
+         for (uint32_t i = 0; i < params.size(); i++) {
+            check(checkusername(params[i].username), "Invalid Username: " + params[i].username);
+
+            auto hashes = hashUsernameVariants(params[i].username);
+            usernameHashes.push_back(hashes[0]);
+            for (auto const& hash : hashes) {
+               variantHashes.push_back(std::make_pair(hash, i));
+            }
+         }
+         std::sort(variantHashes.begin(), variantHashes.end());
+
+         profile_index profiles( _self, _self.value );
+         auto byUsernameHashIdx = profiles.get_index<name("byusername")>();
+
+         for (size_t i = 0; i < variantHashes.size();) {
+            auto const& hash = variantHashes[i].first;
+            size_t runEnd = i + 1;
+            while (runEnd < variantHashes.size() && variantHashes[runEnd].first == hash) {
+               runEnd++;
+            }
+
+            // within the batch a shared hash clashes when it is one profile's own username
+            for (size_t j = i; j < runEnd; j++) {
+               uint32_t owner = variantHashes[j].second;
+               if (usernameHashes[owner] != hash) {
+                  continue;
+               }
+               for (size_t k = i; k < runEnd; k++) {
+                  check(variantHashes[k].second == owner, "Username already exists: " + params[variantHashes[k].second].username);
+               }
+               break;
+            }
+
+            // on-chain, probed once per distinct hash
+            check(byUsernameHashIdx.find(hash) == byUsernameHashIdx.end(), "Username already exists: " + params[variantHashes[i].second].username);
+            i = runEnd;
+         }
+
+         // one profile per account, within the batch and on-chain
+         std::vector<uint64_t> accounts;
+         for (auto const& profileArgs : params) {
+            accounts.push_back(profileArgs.account.value);
+         }
+         std::sort(accounts.begin(), accounts.end());
+         auto byAccountIdx = profiles.get_index<name("byaccount")>();
+         for (size_t i = 0; i < accounts.size(); i++) {
+            check(i == 0 || accounts[i] != accounts[i - 1], "Account already has a profile: " + name{accounts[i]}.to_string());
+            check(byAccountIdx.find(accounts[i]) == byAccountIdx.end(), "Account already has a profile: " + name{accounts[i]}.to_string());
+         }
+
+         bool hashText = get_option(name{"textmode"}) == "hash";
+         profauth_index profauths(_self, _self.value);
+         for (uint32_t i = 0; i < params.size(); i++) {
+            auto& profileArgs = params[i];
+            profiles.emplace(_self, [&](profile& row) {
+               upgradeRow(row);
+               row.id = profileArgs.id;
+               row.username = profileArgs.username;
+               row.usernameHash = usernameHashes[i];
+               row.imgHash = profileArgs.imgHash;
+               row.account = profileArgs.account;
+               row.active = profileArgs.active;
+               setProfileText(row, profileArgs.link, profileArgs.bio, hashText);
+            });
+
+            profauths.emplace(_self, [&](profauth& row) {
+               row.id = profileArgs.id;
+               row.account = profileArgs.account;
+               row.active = profileArgs.active;
+               row.flags = 0;
+            });
+         }
       }
 
       /*
@@ -218,17 +325,16 @@ class [[eosio::contract("flair")]] flair : public contract {
          if (userProfile->username != data.username) {
             checkUsernameExists(data.username);
          }
-         checkAndSanitizeLink(data.link);
-         checkAndSanitizeBio(data.bio);
+         bool hashText = get_option(name{"textmode"}) == "hash";
 
          checksum256 usernameHash = hashUsername(data.username);
          profiles.modify(userProfile, _self, [&](profile& row) {
+            upgradeRow(row);
             row.id = id;
             row.username = data.username;
             row.usernameHash = usernameHash;
             row.imgHash = data.imgHash;
-            row.link = data.link;
-            row.bio = data.bio;
+            setProfileText(row, data.link, data.bio, hashText);
          });
       }
 
@@ -250,25 +356,53 @@ class [[eosio::contract("flair")]] flair : public contract {
 
          profile_index profiles(_self, _self.value);
          auto userProfile = profiles.find(id.value);
+         check(userProfile != profiles.end(), "Profile not found");
+         if (!hasAccountIndexRow(profiles, *userProfile)) {
+            userProfile = rewriteProfile(profiles, userProfile);
+         }
          checksum256 usernameHash = hashUsername(data.username);
 
          if (userProfile->username != data.username) {
             checkUsernameExists(data.username);
          }
+         if (userProfile->account != data.account) {
+            checkAccountFree(data.account, id);
+         }
 
-         checkAndSanitizeLink(data.link);
-         checkAndSanitizeBio(data.bio);
+         bool hashText = get_option(name{"textmode"}) == "hash";
 
          profiles.modify(userProfile, _self, [&](profile& row) {
+            upgradeRow(row);
             row.id = id;
             row.username = data.username;
             row.usernameHash = usernameHash;
             row.imgHash = data.imgHash;
             row.account = data.account;
             row.active = data.active;
-            row.link = data.link;
-            row.bio = data.bio;
+            setProfileText(row, data.link, data.bio, hashText);
          });
+
+         syncProfileAuth(id, data.account, data.active);
+      }
+
+      /*
+         PROFILE BY ACCOUNT - read-only lookup for logins that start from an EOSIO account
+      */
+      struct profilelookup {
+         name id;
+         std::string username;
+         name account;
+         bool active;
+      };
+
+      [[eosio::action]]
+      profilelookup profbyacct(name account) {
+         profile_index profiles(_self, _self.value);
+         auto byAccountIdx = profiles.get_index<name("byaccount")>();
+         auto profileItr = byAccountIdx.find(account.value);
+         check(profileItr != byAccountIdx.end(), "No profile for account.");
+
+         return profilelookup{profileItr->id, profileItr->username, profileItr->account, profileItr->active};
       }
 
       /*
@@ -344,33 +478,40 @@ class [[eosio::contract("flair")]] flair : public contract {
          checksum256 coverHash;
       };
 
+      struct entrystatus {
+         name entryId;
+         name status;         // active, unpaid, underpaid, priceunavail, duplicate, expired, closed or invalid
+         uint64_t contestId;
+         uint64_t voteStart;
+         uint64_t amountOwed; // smallest unit of the currency, estimated from priceHigh
+         uint64_t priceHigh;
+      };
+
       [[eosio::action]]
-      void entercontest(contestargs params) {
-         profile_index profiles(_self, _self.value);
-         auto userProfile = profiles.find(params.userId.value);
+      entrystatus entercontest(contestargs params) {
+         profauth userAuth = getProfileAuth(params.userId);
 
-         level_index levels(_self, _self.value);
-         auto levelItr = levels.find(params.levelId.value);
+         levelrule rule = getLevelRule(params.levelId);
 
-         require_auth( userProfile->account );
-         check(userProfile->active, "Profile must be active to enter a contest");
-         check(levelItr->archived == 0, "Level must be active to enter a contest");
+         require_auth( userAuth.account );
+         check(userAuth.active, "Profile must be active to enter a contest");
+         check(rule.id == params.levelId, "Level not found");
+         check((rule.flags & levelRuleArchived) == 0, "Level must be active to enter a contest");
+         uint64_t scope = rule.categoryId.value;
 
-         uint32_t levelContestCount = countOpenContestForLevel(levelItr->id);
-         print("levelAllowedSimultaneousContests:", levelItr->allowedSimultaneousContests, "\n");
+         uint32_t levelContestCount = countOpenContestForLevel(rule);
+         print("levelAllowedSimultaneousContests:", rule.allowedSimultaneousContests, "\n");
          print("levelContestCount:", levelContestCount, "\n");
-         check(levelItr->allowedSimultaneousContests == 0 || levelContestCount < levelItr->allowedSimultaneousContests, "This level is full");
+         check(rule.allowedSimultaneousContests == 0 || levelContestCount < rule.allowedSimultaneousContests, "This level is full");
 
          uint32_t now = eosio::current_time_point().sec_since_epoch();
 
          // get contest interator
-         contest_index contests(_self, _self.value);
+         contest_index contests(_self, scope);
          auto byLevelIdx = contests.get_index<name("bylevel")>();
          uint64_t submissionsClosed = false;
          auto curContestItr = byLevelIdx.lower_bound(composite_key(params.levelId.value, submissionsClosed));
 
-         uint64_t contestPrice = 0;
-
          bool curContestValid = (
             curContestItr != byLevelIdx.end()
             && curContestItr->levelId == params.levelId
@@ -378,36 +519,26 @@ class [[eosio::contract("flair")]] flair : public contract {
             && now <= curContestItr->votestarttime()
          );
 
-         if (levelItr->fixedPrize > 0) {
-            auto prizefund = get_option_int(name{"prizefund"});
-            print("curContestValid: ", curContestValid, "\n");
-            print("enough in prize fund: ", prizefund >= usdToCurrencyAmount(levelItr->fixedPrize), "\n");
-            check(curContestValid || prizefund >= usdToCurrencyAmount(levelItr->fixedPrize), "Not enough money in prize fund to pay out prize.");
-         }
-
-         entries_index entries(_self, _self.value);
-
-         auto byUserIdAndLevelIdIdx = entries.get_index<name("byuserandlvl")>();         
-         auto itr = byUserIdAndLevelIdIdx.find(composite_key(params.userId.value, params.levelId.value, true));
-
-         // 1. get by index with UserId, LevelId, and open = 1
-         // 2. check if is actually open or not, mark open = 0 if so
-         if(itr != byUserIdAndLevelIdIdx.end() && itr->contestId > 0) {
-            auto contestItr = contests.find(itr->contestId);
-            if (contestItr != contests.end()) {
-               check(now > contestItr->votestarttime(), "You've already entered this contest. You can only submit one entry per contest. (entryId: " + params.id.to_string() + ")");
-
-               byUserIdAndLevelIdIdx.modify(itr, _self, [&](contestEntry& row) {
-                  row.open = false;
-               });
+         withPayout(rule.flags & levelRuleFixedPrize, [&](auto payout) {
+            if constexpr (decltype(payout)::usesPrizeFund) {
+               auto prizefund = get_option_int(name{"prizefund"});
+               print("curContestValid: ", curContestValid, "\n");
+               print("enough in prize fund: ", prizefund >= usdToCurrencyAmount(rule.fixedPrize), "\n");
+               check(curContestValid || prizefund >= usdToCurrencyAmount(rule.fixedPrize), "Not enough money in prize fund to pay out prize.");
             }
-         } else if(itr != byUserIdAndLevelIdIdx.end()) {
-            byUserIdAndLevelIdIdx.modify(itr, _self, [&](contestEntry& row) {
-               row.open = false;
-            });
+         });
+
+         // the user's open entry for the level may still be a legacy one in the contract's own scope
+         closeOpenEntry(_self.value, params, now);
+         if (scope != _self.value) {
+            closeOpenEntry(scope, params, now);
          }
 
+         entries_index entries(_self, scope);
+         checkVideoUnique(entries, params);
+
          auto entryItr = entries.emplace(_self, [&]( contestEntry& row ) {
+            upgradeRow(row);
             row.id = params.id;
             row.userId = params.userId;
             row.levelId = params.levelId;
@@ -422,9 +553,29 @@ class [[eosio::contract("flair")]] flair : public contract {
             row.open = true;
          });
 
-         if(levelItr->price == 0) {
-            activateEntry<decltype(entries), decltype(entryItr)>(entries, entryItr);
-         }
+         entryscope_index entryscopes(_self, _self.value);
+         entryscopes.emplace(_self, [&](entryscope& row) {
+            row.id = params.id;
+            row.categoryId = rule.categoryId;
+         });
+
+         auto ctx = getActivationContext();
+         ctx.levels.push_back(rule);
+         entrystatus result{};
+         // the open contest keeps the price it was created with, a free one activates like a free level
+         uint64_t contestPrice = curContestValid ? curContestItr->price : rule.price;
+         withPricing(rule.flags & levelRuleFree || contestPrice == 0, [&](auto pricing) {
+            if constexpr (decltype(pricing)::activatesOnEnter) {
+               activateEntry<decltype(entries), decltype(entryItr)>(entries, entryItr, scope, ctx, result);
+            } else {
+               result.entryId = params.id;
+               result.priceHigh = priceHighSince(ctx, entryItr->createdAt);
+               // without a price high the amount owed can not be estimated yet
+               result.status = name(result.priceHigh == 0 ? "priceunavail" : "unpaid");
+               result.amountOwed = amountOwed(contestPrice, result.priceHigh, 0);
+            }
+         });
+         return result;
       }
 
       /*
@@ -432,7 +583,7 @@ class [[eosio::contract("flair")]] flair : public contract {
       */
       [[eosio::on_notify("eosio.token::transfer")]]
       void deposit(name from, name to, asset quantity, std::string memo) {
-         std::string currency = get_option(name{'currency'});
+         std::string currency = get_option(currencyOption);
          if (to != _self || quantity.symbol.code().to_string() != currency) {
             if (quantity.symbol.code().to_string() != currency) {
                print("Currency doesn't match: ", quantity.symbol.code().to_string(), " != ", currency);
@@ -440,30 +591,21 @@ class [[eosio::contract("flair")]] flair : public contract {
             return;
          }
 
-         if (memo == "prizefund") {
-            auto prizefund = get_option_int(name{"prizefund"});
-            print("prizefund before:", prizefund, "\n");
-            prizefund = (safeint{prizefund} + safeint{quantity.amount}).amount;
-            print("prizefund after:", prizefund, "\n");
-            set_option(name{"prizefund"}, prizefund);
-         } else {
-            // use memo as id to lookup entry
-            name entryId = name(memo);
-            entries_index entries(_self, _self.value);
-            auto entryItr = entries.find(entryId.value);
-
-            if(entryItr == entries.end()) {
-               print("No entry found - payment invalid, memo: ", memo, " from: ", from, ", amount: ", quantity.to_string(), "\n");
-               return;
-            }
+         name payments = paymentsAccount();
+         check(!payments, "Payments are accepted by " + payments.to_string());
+         applyPayment(from, quantity, memo);
+      }
 
-            // increment entry by asset amount
-            entries.modify(entryItr, _self, [&](contestEntry& row) {
-               row.amount = (safeint{row.amount} + safeint{quantity.amount}).amount;
-            });
-            
-            activateEntry<decltype(entries), decltype(entryItr)>(entries, entryItr);
-         }
+      /*
+         Fund - a payment received by the payments contract, which keeps the tokens
+      */
+      [[eosio::action]]
+      void fund(name from, asset quantity, std::string memo) {
+         name payments = paymentsAccount();
+         check(bool(payments), "No payments contract set.");
+         require_auth(payments);
+         check(quantity.symbol.code().to_string() == get_option(currencyOption), "Currency doesn't match.");
+         applyPayment(from, quantity, memo);
       }
 
       /*
@@ -471,13 +613,13 @@ class [[eosio::contract("flair")]] flair : public contract {
       */
       [[eosio::action]]
       void refundentry(name id, name to, std::string memo) {
-         entries_index entries(_self, _self.value);
+         uint64_t scope = entryScope(id);
+         entries_index entries(_self, scope);
          auto entryItr = entries.find(id.value);
 
-         profile_index profiles(_self, _self.value);
-         auto userProfile = profiles.find(entryItr->userId.value);
+         profauth userAuth = getProfileAuth(entryItr->userId);
 
-         require_auth( userProfile->account );
+         require_auth( userAuth.account );
 
          check(entryItr != entries.end(), "No entry found... id: " + id.to_string() + "memo: " + memo + " to: " + to.to_string());
          check(entryItr->contestId <= 0, "Entry cannot be refunded once it has been assigned to a contest.");
@@ -486,23 +628,28 @@ class [[eosio::contract("flair")]] flair : public contract {
          print(id, " ", entryItr->contestId, " ", entryItr->amount, "\n");
 
          int64_t a = static_cast<int64_t>(entryItr->amount);
-         symbol s = symbol{get_option(name{'currency'}), 4};
+         symbol s = symbol{get_option(currencyOption), 4};
          asset refundAmt = asset{a, s};
 
          print("refund amt: ", refundAmt, "a: ", a, "s: ", s, "\n");
-         action{
-            permission_level{get_self(), name("active")},
-            name("eosio.token"),
-            name("transfer"),
-            std::make_tuple(get_self(), to, refundAmt, memo)
-         }.send();
+         transferBatch transfers{get_self(), paymentsAccount()};
+         transfers.add(to, memo, refundAmt);
+         transfers.flush();
 
          // reset entry asset amount
          entries.modify(entryItr, _self, [&](contestEntry& row) {
+            upgradeRow(row);
             row.amount = 0;
          });
+         rewind_archive_cursor(name("entries"), scope, entryItr->createdAt);
       }
 
+      struct entrymoderation {
+         name entryId;
+         name status;         // blocked, unblocked, unchanged, notincontest or notfound
+         asset prizeRevoked;
+      };
+
       /*
          Block Entry
       */
@@ -510,65 +657,45 @@ class [[eosio::contract("flair")]] flair : public contract {
       void blkentry(name id) {
          require_auth(_self);
 
-         entries_index entries(_self, _self.value);
-         auto entryItr = entries.find(id.value);
-
-         check(entryItr->contestId > 0, "Cannot block an entry that is not in a contest.");
-         check(entryItr->block == 0, "Entry is already blocked.");
-
-         contest_index contests(_self, _self.value);
-         auto contestItr = contests.find(entryItr->contestId);
-
-         entries.modify(entryItr, _self, [&](contestEntry& row) {
-            row.block = 1;
-         });
-
-         contests.modify(contestItr, _self, [&](contest& row) {
-            row.participantCount--;
-         });
-
-         symbol s(get_option(name{'currency'}), 4);
+         auto result = moderateEntries({id}, true)[0];
 
-         if (!entryItr->prizeRevoked && entryItr->prizeGiven.amount > 0 && entryItr->prizeGiven > asset{0, s}) {
-            profile_index profiles(_self, _self.value);
-            auto profileItr = profiles.find(entryItr->userId.value);
-
-            if (profileItr->winnings >= entryItr->prizeGiven) { 
-               profiles.modify(profileItr, _self, [&](profile& row) {
-                  row.winnings = row.winnings - entryItr->prizeGiven;
-               });
-
-               entries.modify(entryItr, _self, [&](contestEntry& row) {
-                  row.prizeRevoked = 1;
-               });
-            }          
-         }
-         
+         check(result.status != name("notfound") && result.status != name("notincontest"), "Cannot block an entry that is not in a contest.");
+         check(result.status == name("blocked"), "Entry is already blocked.");
       }
 
-     /*
+      /*
          Unblock Entry
       */
+      [[eosio::action]]
       void unblkentry(name id) {
          require_auth(_self);
-         
-         entries_index entries(_self, _self.value);
-         auto entryItr = entries.find(id.value);
 
-         check(entryItr->contestId > 0, "Cannot unblock an entry that is not in a contest");
-         check(entryItr->block == 1, "Cannot unblock an entry that is not blocked.");
+         auto result = moderateEntries({id}, false)[0];
 
-         contest_index contests(_self, _self.value);
-         auto contestItr = contests.find(entryItr->contestId);
+         check(result.status != name("notfound") && result.status != name("notincontest"), "Cannot unblock an entry that is not in a contest");
+         check(result.status == name("unblocked"), "Cannot unblock an entry that is not blocked.");
+      }
+
+      /*
+         Block Entries - entries that cannot be blocked are reported, not failed
+      */
+      [[eosio::action]]
+      std::vector<entrymoderation> blkentries(std::vector<name> ids) {
+         require_auth(_self);
+         check(ids.size() > 0, "No entries to block.");
 
+         return moderateEntries(ids, true);
+      }
 
-         entries.modify(entryItr, _self, [&](contestEntry& row) {
-            row.block = 0;
-         });
+      /*
+         Unblock Entries - entries that cannot be unblocked are reported, not failed
+      */
+      [[eosio::action]]
+      std::vector<entrymoderation> unblkentries(std::vector<name> ids) {
+         require_auth(_self);
+         check(ids.size() > 0, "No entries to unblock.");
 
-         contests.modify(contestItr, _self, [&](contest& row) {
-            row.participantCount++;
-         });
+         return moderateEntries(ids, false);
       }
 
       /*
@@ -576,53 +703,57 @@ class [[eosio::contract("flair")]] flair : public contract {
       */
       [[eosio::action]]
       void vote(name voterUserId, name entryId) {
-         profile_index profiles( _self, _self.value );
-         auto userItr = profiles.find(voterUserId.value);
+         profauth voterAuth = getProfileAuth(voterUserId);
 
-         check(userItr != profiles.end(), "User could not be found.");
+         check(voterAuth.id == voterUserId, "User could not be found.");
 
-         require_auth(userItr->account);
+         require_auth(voterAuth.account);
 
-         check(userItr->active, "User must be active.");
+         check(voterAuth.active, "User must be active.");
 
-         entries_index entries(_self, _self.value);
-         auto entryItr = entries.find(entryId.value);
+         uint64_t scope = entryScope(entryId);
+         entries_index entries(_self, scope);
+         contest_index contests(_self, scope);
+         vote_index votes(_self, scope);
+         uint64_t newVoteId = votes.available_primary_key();
+         if (newVoteId == 0) { newVoteId++; }
 
-         check(entryItr != entries.end(), "Entry could not be found.");
+         castVote(voterUserId, entryId, entries, contests, votes, newVoteId);
+      }
 
-         // ensure within voting period
-         contest_index contests(_self, _self.value);
-         auto contestItr = contests.find(entryItr->contestId);
-         uint32_t now = eosio::current_time_point().sec_since_epoch();
+      /*
+         Vote Batch - one voter, one entry per contest
+      */
+      [[eosio::action]]
+      void votebatch(name voterUserId, std::vector<name> entryIds) {
+         profauth voterAuth = getProfileAuth(voterUserId);
 
-         print("votestarttime: ", contestItr->votestarttime(), "\n");
-         print("endtime: ", contestItr->endtime(), "\n");
-         check(now > contestItr->votestarttime(), "Voting has not begun yet.");
-         check(now <= contestItr->endtime(), "Voting has ended for this contest.");
+         check(voterAuth.id == voterUserId, "User could not be found.");
 
-         // determine if already voted
-         vote_index votes(_self, _self.value);
-         auto votesByUserContest = votes.get_index<name("byusrcontest")>();
-         auto voteItr = votesByUserContest.find(composite_key(entryItr->contestId, voterUserId.value));
-         check(voteItr == votesByUserContest.end(), "You've already voted in this contest.");
+         require_auth(voterAuth.account);
 
-         // update entry vote count
-         entries.modify(entryItr, _self, [&](contestEntry& row) {
-            row.votes = (safeint{row.votes} + 1).amount;
-         });
+         check(voterAuth.active, "User must be active.");
+         check(entryIds.size() > 0, "No entries to vote for.");
 
-         // add to votes table
-         uint64_t newVoteId = votes.available_primary_key();
-         if (newVoteId == 0) { newVoteId++; }
-         print("newVoteId: ", newVoteId, "\n");
-         
-         votes.emplace(_self, [&](entryvote& row) {
-            row.id = newVoteId;
-            row.contestId = entryItr->contestId;
-            row.entryId = entryId;
-            row.voterUserId = voterUserId;
-            row.createdAt = eosio::current_time_point().sec_since_epoch();
-         });
+         // grouped by category scope so each scope's tables are opened once, the index keeps the given order within a scope
+         std::vector<std::pair<uint64_t, uint64_t>> scopedEntryIds;  // scope, index into entryIds
+         for (size_t i = 0; i < entryIds.size(); i++) {
+            scopedEntryIds.push_back(std::make_pair(entryScope(entryIds[i]), i));
+         }
+         std::sort(scopedEntryIds.begin(), scopedEntryIds.end());
+
+         for (size_t i = 0; i < scopedEntryIds.size();) {
+            uint64_t scope = scopedEntryIds[i].first;
+            entries_index entries(_self, scope);
+            contest_index contests(_self, scope);
+            vote_index votes(_self, scope);
+            uint64_t newVoteId = votes.available_primary_key();
+            if (newVoteId == 0) { newVoteId++; }
+
+            for (; i < scopedEntryIds.size() && scopedEntryIds[i].first == scope; i++) {
+               castVote(voterUserId, entryIds[scopedEntryIds[i].second], entries, contests, votes, newVoteId);
+            }
+         }
       }
 
       /*
@@ -630,23 +761,19 @@ class [[eosio::contract("flair")]] flair : public contract {
       */
       [[eosio::action]]
       void claim(name profileId, asset amount, name to, std::string memo) {
-         profile_index profiles(_self, _self.value);
-         auto profileItr = profiles.find(profileId.value);
-         check(profileItr->id == profileId, "Cannot find profile");
-         require_auth(profileItr->account);
-         check(profileItr->active, "Profile must be active to claim winnings");
-         check(profileItr->winnings.amount >= amount.amount, "Amount greater than prize winnings");
-
-         profiles.modify(profileItr, _self, [&](profile& row) {
-            row.winnings = row.winnings - amount;
-         });
-
-         action{
-            permission_level{get_self(), name("active")},
-            name("eosio.token"),
-            name("transfer"),
-            std::make_tuple(get_self(), to, amount, memo)
-         }.send();
+         profauth profileAuth = getProfileAuth(profileId);
+         check(profileAuth.id == profileId, "Cannot find profile");
+         require_auth(profileAuth.account);
+         check(profileAuth.active, "Profile must be active to claim winnings");
+         check(amount.amount > 0, "Claim amount must be positive");
+         check(amount.symbol == symbol{get_option(currencyOption), 4}, "Currency doesn't match.");
+         check(getWinnings(profileId).amount >= amount.amount, "Amount greater than prize winnings");
+
+         addWinnings(profileId, -amount);
+
+         transferBatch transfers{get_self(), paymentsAccount()};
+         transfers.add(to, memo, amount);
+         transfers.flush();
       }
 
       /*
@@ -654,16 +781,15 @@ class [[eosio::contract("flair")]] flair : public contract {
       */
       [[eosio::action]]
       void claimusd(name profileId, name claimId, asset amount) {
-         profile_index profiles(_self, _self.value);
-         auto profileItr = profiles.find(profileId.value);
-         check(profileItr->id == profileId, "Cannot find profile");
-         require_auth(profileItr->account);
-         check(profileItr->active, "Profile must be active to claim winnings");
-         check(profileItr->winnings.amount >= amount.amount, "Amount greater than prize winnings");
+         profauth profileAuth = getProfileAuth(profileId);
+         check(profileAuth.id == profileId, "Cannot find profile");
+         require_auth(profileAuth.account);
+         check(profileAuth.active, "Profile must be active to claim winnings");
+         check(amount.amount > 0, "Claim amount must be positive");
+         check(amount.symbol == symbol{get_option(currencyOption), 4}, "Currency doesn't match.");
+         check(getWinnings(profileId).amount >= amount.amount, "Amount greater than prize winnings");
 
-         profiles.modify(profileItr, _self, [&](profile& row) {
-            row.winnings = row.winnings - amount;
-         });
+         addWinnings(profileId, -amount);
 
          std::string claimusdacct = get_option(name{"claimusdacct"});
          std::string claimusdmemo = get_option(name{"claimusdmemo"});
@@ -677,12 +803,9 @@ class [[eosio::contract("flair")]] flair : public contract {
             row.amount = amount;
          });
 
-         action{
-            permission_level{get_self(), name("active")},
-            name("eosio.token"),
-            name("transfer"),
-            std::make_tuple(get_self(), name{claimusdacct}, amount, claimusdmemo)
-         }.send();
+         transferBatch transfers{get_self(), paymentsAccount()};
+         transfers.add(name{claimusdacct}, claimusdmemo, amount);
+         transfers.flush();
       }
 
       /*
@@ -722,8 +845,8 @@ class [[eosio::contract("flair")]] flair : public contract {
       [[eosio::action]]
       void setcurrency(std::string curSymbol) {
          require_auth( _self );
-         set_option(name{'currency'}, curSymbol);
-         print("setcurrency", name{'currency'}, " ", curSymbol);
+         set_option(currencyOption, curSymbol);
+         print("setcurrency", currencyOption, " ", curSymbol);
       }
 
       /*
@@ -736,67 +859,285 @@ class [[eosio::contract("flair")]] flair : public contract {
       }
 
       /*
-         Update
+         Set Profile Text Mode ("hash" keeps only link/bio hashes, "plain" keeps the text)
       */
       [[eosio::action]]
-      void update() {
+      void settextmode(std::string mode) {
          require_auth( _self );
-         print("hello from update \n");
-         distributeContestWinnings();
-         print("distributeContestWinnings completed \n");
-         checkUnavailablePriceEntries();
-         print("checkUnavailablePriceEntries completed \n");
-         archiveContests();
-         print("archiveContests completed \n");
+         check(mode == "hash" || mode == "plain", "Text mode must be hash or plain");
+         set_option(name{"textmode"}, mode);
       }
 
+      /*
+         Set Archive Budget
+      */
       [[eosio::action]]
-      void paycpu() {
-         // noop
+      void setarchbudg(uint64_t budget) {
+         require_auth( _self );
+         set_option(name{"archbudget"}, budget);
       }
 
-   private:
       /*
-         TABLE: categories
+         Set Event Listener - account notified of contest lifecycle events, empty name turns them off
       */
-      struct [[eosio::table]] category {
-         name id;
-         std::string name;
-         uint32_t maxVideoLength;
-         bool archived;
-
-         uint64_t primary_key() const { return id.value; }
-      };
+      [[eosio::action]]
+      void setlistener(name listener) {
+         require_auth( _self );
+         set_option(name{"listener"}, listener.to_string());
+      }
 
-      typedef eosio::multi_index<name("categories"), category> category_index;
+      /*
+         Set Payments Contract - empty to take payments & send transfers from this contract
+      */
+      [[eosio::action]]
+      void setpayments(name payments) {
+         require_auth( _self );
+         set_option(name{"payments"}, payments.to_string());
+      }
 
       /*
-         TABLE: levels
+         Lifecycle Events - sent inline by the contract itself, each one is forwarded to the listener
       */
-      struct [[eosio::table]] level {
-         name id;
-         name categoryId;
-         std::string name;
+      [[eosio::action]]
+      void evactivate(name entryId, name userId, uint64_t contestId) {
+         notifyListener();
+      }
+
+      [[eosio::action]]
+      void evcreated(uint64_t contestId, name levelId, uint32_t participantLimit, uint32_t createdAt) {
+         notifyListener();
+      }
+
+      [[eosio::action]]
+      void evfull(uint64_t contestId) {
+         notifyListener();
+      }
+
+      [[eosio::action]]
+      void evclosed(uint64_t contestId) {
+         notifyListener();
+      }
+
+      // vote start & end are known once minParticipant is reached (right away when there is none)
+      [[eosio::action]]
+      void evvotestart(uint64_t contestId, uint64_t voteStart, uint64_t voteEnd) {
+         notifyListener();
+      }
+
+      // winner row, shared with the results table
+      struct resultwinner {
+         name entryId;
+         name userId;
+         uint32_t votes;
+         asset prize;
+      };
+
+      [[eosio::action]]
+      void evsettled(uint64_t contestId, asset prizePool, asset fee, std::vector<resultwinner> winners) {
+         notifyListener();
+      }
+
+      [[eosio::action]]
+      void evarchived(uint64_t contestId) {
+         notifyListener();
+      }
+
+      /*
+         Log Entry - outcome of each entry funded by a transfer. Token notifications cannot return
+         values, so deposit reports through this inline action in the transfer's trace.
+      */
+      [[eosio::action]]
+      void logentry(entrystatus result) {
+         require_auth(_self);
+      }
+
+      /*
+         Sweep Refunds - refunds & erases funded entries that expired before being assigned to a contest.
+         Shares the archive budget; refunds go to the owner's account, one transfer per account.
+      */
+      [[eosio::action]]
+      void sweeprefunds() {
+         require_auth( _self );
+
+         uint64_t now = eosio::current_time_point().sec_since_epoch();
+         uint64_t entryexp = get_option_int(name{"entryexp"});
+         symbol s = symbol{get_option(currencyOption), 4};
+
+         uint64_t budget = get_option_int(name{"archbudget"});
+         if (budget == 0) { budget = archiveDefaultBudget; }
+         uint64_t spent = 0;
+         transferBatch transfers{get_self(), paymentsAccount()};
+
+         for (auto scope : contestScopes()) {
+            if (!reindexLegacyEntries(scope, budget, spent)) { continue; }
+
+            entries_index entries(_self, scope);
+            auto entriesByCreatedAt = entries.get_index<name("bycreatedat")>();
+
+            // deposit rewinds the cursor when it funds an entry that can no longer activate
+            uint64_t refundCursor = get_archive_cursor(name("refunds"), scope);
+            auto entryItr = entriesByCreatedAt.lower_bound(refundCursor);
+            while(spent < budget && entryItr != entriesByCreatedAt.end() && now > entryItr->createdAt + entryexp) {
+               refundCursor = entryItr->createdAt;
+
+               if (entryItr->contestId == 0 && entryItr->amount > 0) {
+                  profauth ownerAuth = getProfileAuth(entryItr->userId);
+                  if (ownerAuth.id == entryItr->userId) {
+                     print("refund expired entry ", entryItr->id, " to ", ownerAuth.account, "\n");
+                     transfers.add(ownerAuth.account, "Flair expired entry refund", asset{static_cast<int64_t>(entryItr->amount), s});
+                     dropEntryScope(entryItr->id);
+                     entryItr = entriesByCreatedAt.erase(entryItr);
+                     spent += archiveCostEntry;
+                     continue;
+                  }
+               }
+
+               entryItr++;
+               spent += archiveCostScan;
+            }
+
+            set_archive_cursor(name("refunds"), scope, refundCursor);
+         }
+         phaseCompleted("sweepRefunds");
+
+         transfers.flush();
+         phaseCompleted("transfers");
+         print("refund sweep cost spent: ", spent, " of ", budget, "\n");
+      }
+
+      /*
+         Migrate - upgrades rows of entries, contests, profiles or levels still stored in an older
+         layout. Shares the archive budget & resumes from its cursor, scopes already walked are
+         skipped; returns true once every scope has been walked, after which the cursors start over.
+      */
+      [[eosio::action]]
+      bool migrate(name table) {
+         require_auth( _self );
+
+         uint64_t budget = get_option_int(name{"archbudget"});
+         if (budget == 0) { budget = archiveDefaultBudget; }
+
+         if (table == name("entries")) {
+            return migrateScopes<entries_index>(name("migentries"), entrySchemaVersion, contestScopes(), budget);
+         } else if (table == name("contests")) {
+            return migrateScopes<contest_index>(name("migcontests"), contestSchemaVersion, contestScopes(), budget);
+         } else if (table == name("profiles")) {
+            return migrateScopes<profile_index>(name("migprofiles"), profileSchemaVersion, {_self.value}, budget);
+         } else if (table == name("levels")) {
+            return migrateScopes<level_index>(name("miglevels"), levelSchemaVersion, {_self.value}, budget);
+         }
+
+         check(false, "Table is not versioned.");
+         return false;
+      }
+
+      /*
+         Update
+      */
+      [[eosio::action]]
+      void update() {
+         require_auth( _self );
+         print("hello from update \n");
+         transferBatch transfers{get_self(), paymentsAccount()};
+         distributeContestWinnings(transfers);
+         phaseCompleted("distributeContestWinnings");
+         checkUnavailablePriceEntries();
+         phaseCompleted("checkUnavailablePriceEntries");
+         archiveContests();
+         phaseCompleted("archiveContests");
+         transfers.flush();
+         phaseCompleted("transfers");
+      }
+
+      [[eosio::action]]
+      void paycpu() {
+         // noop
+      }
+
+   private:
+      /*
+         TABLE: categories
+      */
+      struct [[eosio::table]] category {
+         eosio::name id;
+         std::string name;
+         uint32_t maxVideoLength;
+         bool archived;
+
+         uint64_t primary_key() const { return id.value; }
+      };
+
+      typedef eosio::multi_index<name("categories"), category> category_index;
+
+      /*
+         TABLE: levels
+      */
+      struct [[eosio::table]] level {
+         eosio::name id;
+         eosio::name categoryId;
+         std::string name;
          bool archived;
          uint32_t price;
          uint32_t participantLimit;
          uint32_t submissionPeriod;
          uint32_t votePeriod;
          uint32_t fee;
-         std::list<uint32_t> prizes;
+         std::vector<uint32_t> prizes;
          uint32_t fixedPrize;
          uint32_t allowedSimultaneousContests;
          uint32_t voteStartUTCHour;
          uint32_t minParticipant;
+         binary_extension<uint8_t> schemaVersion;
 
          uint64_t primary_key() const { return id.value; }
       };
 
       typedef eosio::multi_index<name("levels"), level> level_index;
 
+      /*
+         TABLE: levelrules - the level fields entercontest, activation & settlement read, kept in sync by
+         createlevel & editlevel. flags select the payout & pricing policies. The schedule is selected from
+         the contest row, which copies voteStartUTCHour & minParticipant when it opens. Bits 8 & 16 were
+         written by earlier builds, keep them unused.
+      */
+      static constexpr uint8_t levelRuleArchived = 1;
+      static constexpr uint8_t levelRuleFree = 2;           // price is 0, entries activate on entercontest
+      static constexpr uint8_t levelRuleFixedPrize = 4;     // prizes come out of the prize fund, no fee
+
+      struct [[eosio::table]] levelrule {
+         name id;
+         name categoryId;
+         uint8_t flags;
+         uint8_t voteStartUTCHour;
+         uint16_t fee;                        // per mille of the entry pool, below 1000
+         uint32_t price;
+         uint32_t fixedPrize;
+         uint32_t participantLimit;
+         uint32_t allowedSimultaneousContests;
+         uint32_t submissionPeriod;
+         uint32_t votePeriod;
+         uint32_t minParticipant;
+         std::vector<unsigned_int> prizeSums; // running total of the prize weights up to each rank
+
+         uint64_t primary_key() const { return id.value; }
+         uint32_t prizeWeight(size_t rank) const {
+            return rank == 0 ? prizeSums[0].value : prizeSums[rank].value - prizeSums[rank - 1].value;
+         }
+      };
+
+      typedef eosio::multi_index<name("levelrules"), levelrule> levelrule_index;
+
       /*
          TABLE: profiles
       */
+      // link & bio of profiles stored with textmode "hash", all zero for plain text profiles whose link & bio are in the row
+      struct proftext {
+         checksum256 linkHash;
+         uint32_t linkLength;
+         checksum256 bioHash;
+         uint32_t bioLength;
+      };
+
       struct [[eosio::table]] profile {
          name id;
          std::string username;
@@ -807,17 +1148,66 @@ class [[eosio::contract("flair")]] flair : public contract {
          name account;
          bool active;
          asset winnings;
+         binary_extension<proftext> text;
+         binary_extension<uint8_t> schemaVersion;
 
          uint64_t primary_key() const { return id.value; }
          checksum256 by_username_hash() const { return usernameHash; }
+         uint64_t by_account() const { return account.value; }
       };
 
       typedef eosio::multi_index<
          name("profiles"), 
          profile,
-         indexed_by<name("byusername"), const_mem_fun<profile, checksum256, &profile::by_username_hash>>
+         indexed_by<name("byusername"), const_mem_fun<profile, checksum256, &profile::by_username_hash>>,
+         indexed_by<name("byaccount"), const_mem_fun<profile, uint64_t, &profile::by_account>>
       > profile_index;
 
+      /*
+         TABLE: profauths
+      */
+      static constexpr uint8_t profAuthLegacyWinnings = 1; // profile row still holds winnings not yet in balances
+
+      struct [[eosio::table]] profauth {
+         name id;
+         name account;
+         bool active;
+         uint8_t flags;
+
+         uint64_t primary_key() const { return id.value; }
+      };
+
+      typedef eosio::multi_index<name("profauths"), profauth> profauth_index;
+
+      /*
+         TABLE: balances
+      */
+      struct [[eosio::table]] balance {
+         name id;
+         asset winnings;
+         uint32_t updatedAt;
+
+         uint64_t primary_key() const { return id.value; }
+      };
+
+      typedef eosio::multi_index<name("balances"), balance> balance_index;
+
+      /*
+         TABLE: profstats
+      */
+      struct [[eosio::table]] profstat {
+         name id;
+         uint32_t entries;
+         uint32_t contestsWon;
+         uint64_t votesReceived;
+         asset winnings;         // prizes given less prizes revoked
+         uint32_t revocations;
+
+         uint64_t primary_key() const { return id.value; }
+      };
+
+      typedef eosio::multi_index<name("profstats"), profstat> profstat_index;
+
       /*
          TABLE: openclaims
       */
@@ -837,15 +1227,16 @@ class [[eosio::contract("flair")]] flair : public contract {
       > openclaim_index;
 
       /*
-         TABLE: options
+         TABLE: archcursors
       */
-      struct [[eosio::table]] option {
+      struct [[eosio::table]] archcursor {
          name id;
-         std::string value;
+         uint64_t position;
+
          uint64_t primary_key() const { return id.value; }
       };
 
-      typedef eosio::multi_index<name("options"), option> option_index;
+      typedef eosio::multi_index<name("archcursors"), archcursor> archcursor_index;
 
       /*
          TABLE: curprices
@@ -866,7 +1257,7 @@ class [[eosio::contract("flair")]] flair : public contract {
       > curprice_index;
 
       /*
-         TABLE: entries
+         TABLE: entries - entries, contests & votes are scoped by the category of their level
       */
       struct [[eosio::table]] contestEntry {
          name id;
@@ -884,6 +1275,7 @@ class [[eosio::contract("flair")]] flair : public contract {
          checksum256 coverHash;
          uint32_t createdAt;
          uint32_t votes;
+         binary_extension<uint8_t> schemaVersion;
          
          uint64_t primary_key() const { return id.value; }
          checksum256 by_userid_levelid() const {
@@ -895,17 +1287,36 @@ class [[eosio::contract("flair")]] flair : public contract {
          uint64_t bypriceunavail() const {
             return priceUnavailable;
          }
+         uint64_t byvideo() const {
+            return videoFingerprint(videoHash720p, videoHash1080p);
+         }
+         uint64_t bycreatedat() const {
+            return createdAt;
+         }
+
+         // keys of legacy_entries_index
          checksum256 byvidhashsm() const {
             return videoHash720p;
          }
          checksum256 byvidhashlg() const {
             return videoHash1080p;
          }
-         uint64_t bycreatedat() const {
-            return createdAt;
-         }
       };
 
+      typedef eosio::multi_index<
+         name("entries"), 
+         contestEntry,
+         indexed_by<name("byuserandlvl"), const_mem_fun<contestEntry, checksum256, &contestEntry::by_userid_levelid>>,
+         indexed_by<name("bycontest"), const_mem_fun<contestEntry, uint64_t, &contestEntry::bycontest>>,
+         indexed_by<name("bynoprice"), const_mem_fun<contestEntry, uint64_t, &contestEntry::bypriceunavail>>,
+         indexed_by<name("byvideo"), const_mem_fun<contestEntry, uint64_t, &contestEntry::byvideo>>,
+         indexed_by<name("bycreatedat"), const_mem_fun<contestEntry, uint64_t, &contestEntry::bycreatedat>>
+      > entries_index;
+
+      /*
+         Index layout of entries written before byvideo, bycreatedat was the 6th index. Only used to find
+         & rewrite those rows, see reindexLegacyEntries.
+      */
       typedef eosio::multi_index<
          name("entries"), 
          contestEntry,
@@ -915,7 +1326,19 @@ class [[eosio::contract("flair")]] flair : public contract {
          indexed_by<name("byvidhashsm"), const_mem_fun<contestEntry, checksum256, &contestEntry::byvidhashsm>>,
          indexed_by<name("byvidhashlg"), const_mem_fun<contestEntry, checksum256, &contestEntry::byvidhashlg>>,
          indexed_by<name("bycreatedat"), const_mem_fun<contestEntry, uint64_t, &contestEntry::bycreatedat>>
-      > entries_index;
+      > legacy_entries_index;
+
+      /*
+         TABLE: entryscopes - category of each entry, for actions that only get the entry id
+      */
+      struct [[eosio::table]] entryscope {
+         name id;
+         name categoryId;
+
+         uint64_t primary_key() const { return id.value; }
+      };
+
+      typedef eosio::multi_index<name("entryscopes"), entryscope> entryscope_index;
 
       /*
          TABLE: contests
@@ -935,32 +1358,14 @@ class [[eosio::contract("flair")]] flair : public contract {
          bool paid;
          uint32_t minParticipant;
          uint32_t lastEntryAddedAt;
+         binary_extension<uint8_t> schemaVersion;
 
          uint64_t primary_key() const { return id; }
          uint128_t bylevel() const { return composite_key(levelId.value, submissionsClosed); }
          uint64_t votestarttime() const {
-            if (minParticipant > 0) {
-               if(lastEntryAddedAt > 0) {
-                  return lastEntryAddedAt;
-               } else if (minParticipant > participantCount) {
-                  return 253370764800; // Jan 1, 9999 @ 12:00:00 AM
-               } else {
-                  return (safeint{createdAt} + safeint{submissionPeriod}).amount;
-               }
-            }
-
-            if (voteStartUTCHour == 0) {
-               return (safeint{createdAt} + safeint{submissionPeriod}).amount;
-            }
-
-            auto hours = (createdAt / 3600) % 24;
-            auto minutes = (createdAt / 60) % 60;
-            auto seconds = createdAt % 60;
-            if (hours < voteStartUTCHour) {
-               return createdAt - (minutes * 60) - seconds + ((voteStartUTCHour - hours) * 3600);
-            } else {
-               return createdAt - (minutes * 60) - seconds + ((24 + voteStartUTCHour - hours) * 3600);
-            }
+            return withSchedule(*this, [&](auto schedule) {
+               return decltype(schedule)::voteStart(*this);
+            });
          }
          uint64_t endtime() const { return (safeint{votestarttime()} + safeint{votePeriod}).amount; }
          uint128_t level_and_start() const { 
@@ -999,77 +1404,419 @@ class [[eosio::contract("flair")]] flair : public contract {
       > vote_index;
 
       /*
-         Distribute Contest Winnings - used within update
+         TABLE: results
       */
-      void distributeContestWinnings() {
-         print("distributeContestWinnings \n");
-         contest_index contests( _self, _self.value );
-         auto contestsByEndtime = contests.get_index<name("byendtime")>();
-         uint64_t now = eosio::current_time_point().sec_since_epoch();
-         auto contestItrEndTime = contestsByEndtime.upper_bound(now - 1);
+      struct [[eosio::table]] contestresult {
+         uint64_t id;
+         name levelId;
+         asset prizePool;
+         asset fee;
+         uint32_t participantCount;
+         uint32_t totalVotes;
+         std::vector<resultwinner> winners;
+         checksum256 standingsHash;
+         uint32_t settledAt;
 
-         if (contestItrEndTime == contestsByEndtime.begin()) {
-            print("no unpaid contests ending at or before ", now - 1, "\n");
-            return;
-         } else {
-            contestItrEndTime--;
-         }
+         uint64_t primary_key() const { return id; }
+      };
 
-         auto contestItr = contestItrEndTime;
+      typedef eosio::multi_index<name("results"), contestresult> result_index;
 
-         bool hitBeginning = false;
-         while(!hitBeginning && contestItr->paid == false) {
-            auto winnerResults = getContestWinners<decltype(contestItr)>(contestItr);
-            auto winnersArr = std::get<0>(winnerResults);
-            auto prizeRemainder = std::get<1>(winnerResults);
+      /*
+         Apply Payment - prize fund top up or entry funding, for transfers to this contract or forwarded by the
+         payments contract
+      */
+      void applyPayment(name from, const asset& quantity, const std::string& memo) {
+         if (memo == "prizefund") {
+            auto prizefund = get_option_int(name{"prizefund"});
+            print("prizefund before:", prizefund, "\n");
+            prizefund = (safeint{prizefund} + safeint{quantity.amount}).amount;
+            print("prizefund after:", prizefund, "\n");
+            set_option(name{"prizefund"}, prizefund);
+         } else if (memo.rfind(entriesMemoPrefix, 0) == 0) {
+            // one transfer funding several entries, all of it is applied or the transfer fails
+            auto funding = parseEntriesMemo(std::string_view(memo).substr(std::string_view(entriesMemoPrefix).size()), quantity);
 
-            for (auto const& winnerTuple : winnersArr) {
-               auto winner = std::get<0>(winnerTuple);
-               auto entryId = std::get<1>(winnerTuple);
-               auto winnerPrize = std::get<2>(winnerTuple);
+            std::vector<uint64_t> scopes;
+            for (auto const& entryFunding : funding) {
+               scopes.push_back(entryScope(entryFunding.first));
+               entries_index entries(_self, scopes.back());
+               auto entryItr = entries.find(entryFunding.first.value);
+               check(entryItr != entries.end(), "No entry found: " + entryFunding.first.to_string());
 
-               profile_index profiles(_self, _self.value);
-               auto profileItr = profiles.find(winner);
-               if (profileItr == profiles.end()) {
-                  continue;
-               }
+               entries.modify(entryItr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
+                  row.amount = (safeint{row.amount} + safeint{entryFunding.second}).amount;
+               });
+            }
 
-               entries_index entries(_self, _self.value);
-               auto entryItr = entries.find(entryId);
-               if (entryItr == entries.end()) {
-                  continue;
+            auto ctx = getActivationContext();
+            entrystatus result;
+            for (size_t i = 0; i < funding.size(); i++) {
+               entries_index entries(_self, scopes[i]);
+               auto entryItr = entries.find(funding[i].first.value);
+               if (!activateEntry<decltype(entries), decltype(entryItr)>(entries, entryItr, scopes[i], ctx, result)) {
+                  rewind_archive_cursor(name("refunds"), scopes[i], entryItr->createdAt);
                }
+               logEntryStatus(result);
+            }
+         } else {
+            // use memo as id to lookup entry
+            name entryId = name(memo);
+            uint64_t scope = entryScope(entryId);
+            entries_index entries(_self, scope);
+            auto entryItr = entries.find(entryId.value);
 
-               if (winnerPrize.amount > 0) { 
-                  profiles.modify(profileItr, _self, [&](profile& row) {
-                     if (row.winnings.amount > 0) {
-                        row.winnings = row.winnings + winnerPrize;
-                     } else {
-                        row.winnings = winnerPrize;
-                     }
-                  });
+            if(entryItr == entries.end()) {
+               print("No entry found - payment invalid, memo: ", memo, " from: ", from, ", amount: ", quantity.to_string(), "\n");
+               return;
+            }
 
-                  entries.modify(entryItr, _self, [&](contestEntry& row) {
-                     row.prizeGiven = winnerPrize;
-                  });
+            // increment entry by asset amount
+            entries.modify(entryItr, _self, [&](contestEntry& row) {
+               upgradeRow(row);
+               row.amount = (safeint{row.amount} + safeint{quantity.amount}).amount;
+            });
+            
+            auto ctx = getActivationContext();
+            entrystatus result;
+            if (!activateEntry<decltype(entries), decltype(entryItr)>(entries, entryItr, scope, ctx, result)) {
+               rewind_archive_cursor(name("refunds"), scope, entryItr->createdAt);
+            }
+            logEntryStatus(result);
+         }
+      }
+
+      name paymentsAccount() {
+         return name(get_option(name{"payments"}));
+      }
+
+      /*
+         Outbound token transfers, summed per (recipient, memo) and sent as one transfer each on flush. With a
+         payments contract set, it holds the tokens & each transfer goes out through its payout action. Only
+         positive quantities are taken, callers skip amounts that may be zero.
+      */
+      struct transferBatch {
+         name from;
+         name payments;
+         std::vector<std::tuple<name, std::string, asset>> transfers;
+
+         void add(name to, const std::string& memo, const asset& quantity) {
+            check(quantity.amount > 0, "Transfer quantity must be positive");
+
+            for (auto& transfer : transfers) {
+               if (std::get<0>(transfer) == to && std::get<1>(transfer) == memo && std::get<2>(transfer).symbol == quantity.symbol) {
+                  std::get<2>(transfer) += quantity;
+                  return;
                }
             }
+            transfers.push_back(std::make_tuple(to, memo, quantity));
+         }
+
+         void flush() {
+            for (auto const& transfer : transfers) {
+               if (payments) {
+                  action{
+                     permission_level{from, name("active")},
+                     payments,
+                     name("payout"),
+                     std::make_tuple(std::get<0>(transfer), std::get<2>(transfer), std::get<1>(transfer))
+                  }.send();
+                  continue;
+               }
 
-            name feeacct(get_option(name{"feeacct"}));
-            std::string feeacctmemo = get_option(name{"feeacctmemo"});
-            print("feeacct: ", feeacct, ", memo: ", feeacctmemo, ", amount: ", prizeRemainder, "\n");
-            if (prizeRemainder.amount > 0) {
                action{
-                  permission_level{get_self(), name("active")},
+                  permission_level{from, name("active")},
                   name("eosio.token"),
                   name("transfer"),
-                  std::make_tuple(get_self(), feeacct, prizeRemainder, feeacctmemo)
+                  std::make_tuple(from, std::get<0>(transfer), std::get<2>(transfer), std::get<1>(transfer))
                }.send();
             }
+            transfers.clear();
+         }
+      };
 
-            contestsByEndtime.modify(contestItr, _self, [&](contest& row) {
-               row.paid = true;
+      /*
+         Lifecycle events are only sent while a listener is set, the option is read once per action
+      */
+      name listener;
+      bool listenerLoaded = false;
+
+      name eventListener() {
+         if (!listenerLoaded) {
+            listener = name(get_option(name{"listener"}));
+            listenerLoaded = true;
+         }
+         return listener;
+      }
+
+      template<typename... Args>
+      void emitEvent(name event, Args... args) {
+         if (!eventListener()) {
+            return;
+         }
+
+         action{
+            permission_level{_self, name("active")},
+            _self,
+            event,
+            std::make_tuple(args...)
+         }.send();
+      }
+
+      void logEntryStatus(const entrystatus& result) {
+         action{
+            permission_level{_self, name("active")},
+            _self,
+            name("logentry"),
+            std::make_tuple(result)
+         }.send();
+      }
+
+      void notifyListener() {
+         require_auth(_self);
+         if (eventListener()) {
+            require_recipient(eventListener());
+         }
+      }
+
+      /*
+         Moderate Entries - blocks or unblocks entries in order. participantCount is written once per contest &
+         revoked prizes once per profile, each profile's balance is checked entry by entry as single calls would.
+      */
+      std::vector<entrymoderation> moderateEntries(const std::vector<name>& ids, bool block) {
+         std::vector<entrymoderation> results;
+         std::vector<uint64_t> scopes;                                // category scope of each result's entry
+         std::vector<std::pair<uint64_t, uint64_t>> changedContests;  // scope, contest id
+         std::vector<std::pair<uint64_t, uint64_t>> prizedEntries;    // user id, index into results
+
+         for (auto const& id : ids) {
+            entrymoderation result{id, name("unchanged"), asset{}};
+            scopes.push_back(entryScope(id));
+            entries_index entries(_self, scopes.back());
+            auto entryItr = entries.find(id.value);
+
+            if (entryItr == entries.end()) {
+               result.status = name("notfound");
+            } else if (entryItr->contestId == 0) {
+               result.status = name("notincontest");
+            } else if (entryItr->block != block) {
+               entries.modify(entryItr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
+                  row.block = block;
+               });
+               changedContests.push_back(std::make_pair(scopes.back(), entryItr->contestId));
+               if (block && !entryItr->prizeRevoked && entryItr->prizeGiven.amount > 0) {
+                  prizedEntries.push_back(std::make_pair(entryItr->userId.value, results.size()));
+               }
+               result.status = block ? name("blocked") : name("unblocked");
+            }
+
+            results.push_back(result);
+         }
+
+         std::sort(changedContests.begin(), changedContests.end());
+         for (size_t i = 0; i < changedContests.size();) {
+            size_t runEnd = i + 1;
+            while (runEnd < changedContests.size() && changedContests[runEnd] == changedContests[i]) {
+               runEnd++;
+            }
+
+            uint32_t count = runEnd - i;
+            contest_index contests(_self, changedContests[i].first);
+            contests.modify(contests.find(changedContests[i].second), _self, [&](contest& row) {
+               upgradeRow(row);
+               if (block) {
+                  row.participantCount -= count;
+               } else {
+                  row.participantCount += count;
+               }
             });
+            i = runEnd;
+         }
+
+         // the index keeps each profile's prizes in the order the entries were given
+         std::sort(prizedEntries.begin(), prizedEntries.end());
+         for (size_t i = 0; i < prizedEntries.size();) {
+            name userId = name{prizedEntries[i].first};
+            asset winnings = getWinnings(userId);
+            asset revoked = winnings;
+            revoked.amount = 0;
+            uint32_t revokedCount = 0;
+
+            for (; i < prizedEntries.size() && prizedEntries[i].first == userId.value; i++) {
+               auto& result = results[prizedEntries[i].second];
+               entries_index entries(_self, scopes[prizedEntries[i].second]);
+               auto entryItr = entries.find(result.entryId.value);
+               if (winnings.amount - revoked.amount < entryItr->prizeGiven.amount) {
+                  continue;
+               }
+
+               revoked.amount += entryItr->prizeGiven.amount;
+               revokedCount++;
+               result.prizeRevoked = entryItr->prizeGiven;
+               entries.modify(entryItr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
+                  row.prizeRevoked = 1;
+               });
+            }
+
+            if (revoked.amount > 0) {
+               addWinnings(userId, -revoked);
+               updateProfStats(userId, [&](profstat& row) {
+                  // prizes given before profstats existed were never counted
+                  row.winnings.symbol = revoked.symbol;
+                  row.winnings.amount = std::max(row.winnings.amount - revoked.amount, int64_t(0));
+                  row.revocations += revokedCount;
+               });
+            }
+         }
+
+         return results;
+      }
+
+      /*
+         Cast Vote - used within vote & votebatch, the caller checks the voter's auth
+      */
+      void castVote(name voterUserId, name entryId, entries_index& entries, contest_index& contests, vote_index& votes, uint64_t& newVoteId) {
+         auto entryItr = entries.find(entryId.value);
+
+         check(entryItr != entries.end(), "Entry could not be found.");
+
+         // ensure within voting period
+         auto contestItr = contests.find(entryItr->contestId);
+         uint32_t now = eosio::current_time_point().sec_since_epoch();
+
+         print("votestarttime: ", contestItr->votestarttime(), "\n");
+         print("endtime: ", contestItr->endtime(), "\n");
+         check(now > contestItr->votestarttime(), "Voting has not begun yet.");
+         check(now <= contestItr->endtime(), "Voting has ended for this contest.");
+
+         // determine if already voted
+         auto votesByUserContest = votes.get_index<name("byusrcontest")>();
+         auto voteItr = votesByUserContest.find(composite_key(entryItr->contestId, voterUserId.value));
+         check(voteItr == votesByUserContest.end(), "You've already voted in this contest.");
+
+         // update entry vote count
+         entries.modify(entryItr, _self, [&](contestEntry& row) {
+            upgradeRow(row);
+            row.votes = (safeint{row.votes} + 1).amount;
+         });
+         updateProfStats(entryItr->userId, [&](profstat& row) {
+            row.votesReceived++;
+         });
+
+         // add to votes table
+         print("newVoteId: ", newVoteId, "\n");
+         
+         votes.emplace(_self, [&](entryvote& row) {
+            row.id = newVoteId;
+            row.contestId = entryItr->contestId;
+            row.entryId = entryId;
+            row.voterUserId = voterUserId;
+            row.createdAt = now;
+         });
+         newVoteId++;
+      }
+
+      /*
+         Distribute Contest Winnings - used within update
+      */
+      void distributeContestWinnings(transferBatch& transfers) {
+         print("distributeContestWinnings \n");
+         for (auto scope : contestScopes()) {
+            distributeScopeWinnings(scope, transfers);
+         }
+      }
+
+      void distributeScopeWinnings(uint64_t scope, transferBatch& transfers) {
+         contest_index contests( _self, scope );
+         auto contestsByEndtime = contests.get_index<name("byendtime")>();
+         uint64_t now = eosio::current_time_point().sec_since_epoch();
+         auto contestItrEndTime = contestsByEndtime.upper_bound(now - 1);
+
+         if (contestItrEndTime == contestsByEndtime.begin()) {
+            print("no unpaid contests ending at or before ", now - 1, "\n");
+            return;
+         } else {
+            contestItrEndTime--;
+         }
+
+         auto contestItr = contestItrEndTime;
+
+         name feeacct(get_option(name{"feeacct"}));
+         std::string feeacctmemo = get_option(name{"feeacctmemo"});
+
+         bool hitBeginning = false;
+         while(!hitBeginning && contestItr->paid == false) {
+            auto winnerResults = withPayout(contestItr->fixedPrize > 0, [&](auto payout) {
+               return getContestWinners<decltype(payout), decltype(contestItr)>(scope, contestItr);
+            });
+            auto winnersArr = std::get<0>(winnerResults);
+            auto prizeRemainder = std::get<1>(winnerResults);
+            auto contestPrize = std::get<2>(winnerResults);
+            auto totalVotes = std::get<3>(winnerResults);
+            auto standingsHash = std::get<4>(winnerResults);
+            std::vector<resultwinner> paidWinners;
+
+            for (auto const& winnerTuple : winnersArr) {
+               auto winner = std::get<0>(winnerTuple);
+               auto entryId = std::get<1>(winnerTuple);
+               auto winnerPrize = std::get<2>(winnerTuple);
+               auto winnerVotes = std::get<3>(winnerTuple);
+
+               profauth winnerAuth = getProfileAuth(name{winner});
+               if (winnerAuth.id.value != winner) {
+                  continue;
+               }
+
+               entries_index entries(_self, scope);
+               auto entryItr = entries.find(entryId);
+               if (entryItr == entries.end()) {
+                  continue;
+               }
+
+               if (winnerPrize.amount > 0) { 
+                  addWinnings(winnerAuth.id, winnerPrize);
+
+                  entries.modify(entryItr, _self, [&](contestEntry& row) {
+                     upgradeRow(row);
+                     row.prizeGiven = winnerPrize;
+                  });
+                  updateProfStats(winnerAuth.id, [&](profstat& row) {
+                     row.contestsWon++;
+                     row.winnings = row.winnings.amount == 0 ? winnerPrize : row.winnings + winnerPrize;
+                  });
+
+                  paidWinners.push_back(resultwinner{name{entryId}, name{winner}, winnerVotes, winnerPrize});
+               }
+            }
+
+            print("feeacct: ", feeacct, ", memo: ", feeacctmemo, ", amount: ", prizeRemainder, "\n");
+            if (prizeRemainder.amount > 0) {
+               transfers.add(feeacct, feeacctmemo, prizeRemainder);
+            }
+
+            result_index contestResults(_self, _self.value);
+            contestResults.emplace(_self, [&](contestresult& row) {
+               row.id = contestItr->id;
+               row.levelId = contestItr->levelId;
+               row.prizePool = contestPrize;
+               row.fee = prizeRemainder;
+               row.participantCount = contestItr->participantCount;
+               row.totalVotes = totalVotes;
+               row.winners = paidWinners;
+               row.standingsHash = standingsHash;
+               row.settledAt = now;
+            });
+
+            contestsByEndtime.modify(contestItr, _self, [&](contest& row) {
+               upgradeRow(row);
+               row.paid = true;
+            });
+            emitEvent(name("evsettled"), contestItr->id, contestPrize, prizeRemainder, paidWinners);
+            rewind_archive_cursor(name("votes"), scope, contestItr->endtime());
+            rewind_archive_cursor(name("contests"), scope, contestItr->endtime());
 
             hitBeginning = contestItr == contestsByEndtime.begin();
             if (!hitBeginning) {
@@ -1078,290 +1825,781 @@ class [[eosio::contract("flair")]] flair : public contract {
          }              
       }
 
-      template <typename contestItrT>
-      std::tuple<std::list<std::tuple<uint64_t, uint64_t, asset>>, asset> getContestWinners(contestItrT contestItr) {
+      struct rankedEntry {
+         uint32_t votes;
+         uint64_t userId;
+         uint64_t entryId;
+      };
+
+      template <typename payoutT, typename contestItrT>
+      std::tuple<std::vector<std::tuple<uint64_t, uint64_t, asset, uint32_t>>, asset, asset, uint32_t, checksum256> getContestWinners(uint64_t scope, contestItrT contestItr) {
          print("getContestWinners contest id: ", contestItr->id, "\n");
-         entries_index entries(_self, _self.value);
+         entries_index entries(_self, scope);
          auto entriesByContest = entries.get_index<name("bycontest")>();
          auto contestEntriesItr = entriesByContest.lower_bound(contestItr->id);
-         level_index levels(_self, _self.value);
-         auto levelItr = levels.find(contestItr->levelId.value);
+         levelrule rule = getLevelRule(contestItr->levelId);
+         size_t prizeRanks = rule.prizeSums.size();
 
-         symbol s(get_option(name{'currency'}), 4);
+         symbol s(get_option(currencyOption), 4);
 
-         asset contestPrize(0, s);
-         std::map<uint64_t, std::list<std::tuple<uint64_t, uint64_t>>> winners;
-         uint64_t votes = 0;
-
-         if (contestItr->fixedPrize > 0) {
-            contestPrize = asset{contestItr->fixedPrize, s};
-         }
+         asset entryPayments(0, s);
+         std::vector<rankedEntry> ranked;
+         uint32_t totalVotes = 0;
 
          // sum amount of all entry within contest & find winner(s)
          for (auto entryItr = contestEntriesItr; entryItr->contestId == contestItr->id && entryItr != entriesByContest.end(); entryItr++) {
             if (entryItr->block) { continue; }
 
             print("user: ", entryItr->userId, " votes: ", entryItr->votes, " amount: ", entryItr->amount, "\n");
-            if (contestItr->fixedPrize == 0) {
-               contestPrize += asset(entryItr->amount, s);
-            }
-            std::list<std::tuple<uint64_t, uint64_t>> winnersByVotes; 
-            if(winners.find(entryItr->votes) != winners.end()) {
-               winnersByVotes = winners[entryItr->votes];
-               winnersByVotes.push_back(std::make_tuple(entryItr->userId.value, entryItr->id.value));
-            } else {
-               winnersByVotes = {std::make_tuple(entryItr->userId.value, entryItr->id.value)};
+            if constexpr (!payoutT::usesPrizeFund) {
+               entryPayments += asset(entryItr->amount, s);
             }
-            winners[entryItr->votes] = winnersByVotes;
+            totalVotes = (safeint{totalVotes} + safeint{entryItr->votes}).amount;
+            ranked.push_back(rankedEntry{entryItr->votes, entryItr->userId.value, entryItr->id.value});
          }
 
-         print("level fee: ", levelItr->fee, "\n");
-         check(levelItr->fee < 1000, "interval error: fee is too large, must be below 100%");
-         asset feeAmount = contestPrize * levelItr->fee / 1000;
-         if (contestItr->fixedPrize > 0) {
-            feeAmount.set_amount(0);
-         }
+         // most votes first, entries with the same votes share a rank & keep their bycontest order, which is by entry id
+         std::sort(ranked.begin(), ranked.end(), [](const rankedEntry& a, const rankedEntry& b) {
+            return a.votes > b.votes || (a.votes == b.votes && a.entryId < b.entryId);
+         });
+
+         print("level fee: ", rule.fee, "\n");
+         asset contestPrize = payoutT::prizePool(entryPayments, contestItr->fixedPrize);
+         asset feeAmount = payoutT::fee(contestPrize, rule.fee);
          asset winTotal = contestPrize - feeAmount;
          asset prizeRemainder = contestPrize;
 
+         // entries ranked within the prizes; without ties their weight is the running total at the last one
          safeint totalWinnersWeight(0);
+         size_t winners = 0;
+         bool tied = false;
 
-         auto rank = 1;
-         auto prize = levelItr->prizes.begin();
-         for(auto rankWinners = winners.rbegin(); rankWinners != winners.rend(); ++rankWinners) {
-            if (rank > levelItr->prizes.size()) {
+         size_t rank = 0;
+         for (; winners < ranked.size(); winners++) {
+            if (winners > 0 && ranked[winners].votes != ranked[winners - 1].votes) {
+               ++rank;
+            } else if (winners > 0) {
+               tied = true;
+            }
+            if (rank >= prizeRanks) {
                break;
             }
-
-            for (auto const& winner : rankWinners->second) {
-               totalWinnersWeight = totalWinnersWeight + safeint{*prize};
+         }
+         if (!tied) {
+            totalWinnersWeight = winners > 0 ? safeint{rule.prizeSums[winners - 1].value} : safeint(0);
+         } else {
+            rank = 0;
+            for (size_t i = 0; i < winners; i++) {
+               if (i > 0 && ranked[i].votes != ranked[i - 1].votes) {
+                  ++rank;
+               }
+               totalWinnersWeight = totalWinnersWeight + safeint{rule.prizeWeight(rank)};
             }
-
-            ++rank;
-            ++prize;
          }
 
          print("totalWinnersWeight: ", totalWinnersWeight.amount, ", winTotal: ", winTotal, ", fee: ", feeAmount, "\n");
 
-         std::list<std::tuple<uint64_t, uint64_t, asset>> results;
+         // hash over the final standings (entry id & votes, most votes first)
+         std::vector<char> standings;
+         for (auto const& entry : ranked) {
+            standings.insert(standings.end(), (const char*)&entry.entryId, (const char*)&entry.entryId + sizeof(entry.entryId));
+            standings.insert(standings.end(), (const char*)&entry.votes, (const char*)&entry.votes + sizeof(entry.votes));
+         }
+         checksum256 standingsHash = sha256(standings.data(), standings.size());
+
+         std::vector<std::tuple<uint64_t, uint64_t, asset, uint32_t>> results;
 
          if (winTotal.amount > 0 && totalWinnersWeight > 0) {
-            rank = 1;
-            prize = levelItr->prizes.begin();
-            for(auto rankWinners = winners.rbegin(); rankWinners != winners.rend(); ++rankWinners) {
-               if (rank > levelItr->prizes.size()) {
-                  break;
+            rank = 0;
+            for (size_t i = 0; i < winners; i++) {
+               if (i > 0 && ranked[i].votes != ranked[i - 1].votes) {
+                  ++rank;
                }
 
-               for (auto const& winnerRes : rankWinners->second) {
-                  auto winner = std::get<0>(winnerRes);
-                  auto entryId = std::get<1>(winnerRes);
-                  safeint total = safeint{winTotal.amount} * safeint{*prize} / safeint{totalWinnersWeight};
-                  asset winnerPrize(total.amount, s);
-                  prizeRemainder -= winnerPrize;
+               safeint total = safeint{winTotal.amount} * safeint{rule.prizeWeight(rank)} / safeint{totalWinnersWeight};
+               asset winnerPrize(total.amount, s);
+               prizeRemainder -= winnerPrize;
 
-                  results.push_back(std::make_tuple(winner, entryId, winnerPrize));
-               }
-
-               ++rank;
-               ++prize;
+               results.push_back(std::make_tuple(ranked[i].userId, ranked[i].entryId, winnerPrize, ranked[i].votes));
             }
          }
 
-         return std::make_tuple(results, prizeRemainder);
+         return std::make_tuple(results, prizeRemainder, contestPrize, totalVotes, standingsHash);
       }
 
       /*
          Re-check Entries marked as UnavailablePrice  - used within update
       */
       void checkUnavailablePriceEntries() {
-         entries_index entries(_self, _self.value);
-         auto entriesByNoPrice = entries.get_index<name("bynoprice")>();
-         auto noPriceEntriesItr = entriesByNoPrice.lower_bound(true);
-
+         auto ctx = getActivationContext();
+         entrystatus result{};
          int limitIndex = 0;
-         auto entryItr = noPriceEntriesItr;
-         while(entryItr != entriesByNoPrice.end() && limitIndex < 500) {
-            auto thisEntryItr = entryItr; // prevent activate entry from resorting after modification
-            limitIndex++;
-            ++entryItr;
-            activateEntry<decltype(entriesByNoPrice), decltype(thisEntryItr)>(entriesByNoPrice, thisEntryItr);
+
+         for (auto scope : contestScopes()) {
+            entries_index entries(_self, scope);
+            auto entriesByNoPrice = entries.get_index<name("bynoprice")>();
+            auto entryItr = entriesByNoPrice.lower_bound(true);
+
+            while(entryItr != entriesByNoPrice.end() && limitIndex < 500) {
+               auto thisEntryItr = entryItr; // prevent activate entry from resorting after modification
+               limitIndex++;
+               ++entryItr;
+               activateEntry<decltype(entriesByNoPrice), decltype(thisEntryItr)>(entriesByNoPrice, thisEntryItr, scope, ctx, result);
+            }
+         }
+      }
+
+      /*
+         Archive Contests - used within update
+
+         Resumable sweeper: each phase keeps its position in the archcursors table and
+         every call stops once the estimated cost of the rows it touched reaches the
+         archbudget option. Votes of paid contests go right away, entries & contests
+         after entryarchsec. Category scopes are swept one after another and share
+         the budget, each with its own cursors.
+      */
+      static constexpr uint64_t archiveCostScan = 1;    // row read and skipped
+      static constexpr uint64_t archiveCostVote = 3;    // primary + 2 secondary rows
+      static constexpr uint64_t archiveCostEntry = 8;   // primary + 6 secondary rows + entryscopes row
+      static constexpr uint64_t archiveCostContest = 4; // primary + 3 secondary rows
+      static constexpr uint64_t archiveCostReindex = 13; // primary + 6 legacy secondary rows, primary + 5 secondary rows
+      static constexpr uint64_t archiveDefaultBudget = 1500;
+
+      // ends a phase of an action, tests/native/replay times the work between these prints
+      void phaseCompleted(const char* phase) {
+         print(phase, " completed \n");
+      }
+
+      void archiveContests() {
+         uint64_t budget = get_option_int(name{"archbudget"});
+         if (budget == 0) { budget = archiveDefaultBudget; }
+         uint64_t spent = 0;
+
+         for (auto scope : contestScopes()) {
+            archiveScope(scope, budget, spent);
+         }
+         print("archive cost spent: ", spent, " of ", budget, "\n");
+      }
+
+      void archiveScope(uint64_t scope, uint64_t budget, uint64_t& spent) {
+         contest_index contests( _self, scope );
+         auto contestsByEndtime = contests.get_index<name("byendtime")>();
+
+         uint64_t now = eosio::current_time_point().sec_since_epoch();
+         uint64_t archSec = get_option_int(name{"entryarchsec"});
+
+         // votes are only needed while voting is open, the results row keeps the totals once paid
+         uint64_t voteCursor = get_archive_cursor(name("votes"), scope);
+         auto voteContestItr = contestsByEndtime.lower_bound(voteCursor);
+         while(spent < budget && voteContestItr != contestsByEndtime.end() && now > voteContestItr->endtime()) {
+            voteCursor = voteContestItr->endtime();
+            spent += archiveCostScan;
+
+            // unpaid contests are passed over; settlement rewinds the cursor when it pays one
+            if (voteContestItr->paid && !archiveContestVotes(scope, voteContestItr->id, budget, spent)) {
+               break;
+            }
+            voteContestItr++;
+         }
+
+         set_archive_cursor(name("votes"), scope, voteCursor);
+
+         // the entries erased below have to be in the current index layout
+         if (!reindexLegacyEntries(scope, budget, spent)) { return; }
+
+         uint64_t contestCursor = get_archive_cursor(name("contests"), scope);
+         auto contestItr = contestsByEndtime.lower_bound(contestCursor);
+         while(spent < budget && contestItr != contestsByEndtime.end() && now > contestItr->endtime() + archSec) {
+            contestCursor = contestItr->endtime();
+
+            if (!contestItr->paid) {
+               spent += archiveCostScan;
+               contestItr++;
+               continue;
+            }
+
+            uint64_t contestId = contestItr->id;
+            contestItr++;
+            if (!archiveContest(contests, contestId, budget, spent)) {
+               break;
+            }
+         }
+
+         set_archive_cursor(name("contests"), scope, contestCursor);
+
+         // entries never assigned to a contest nor paid for, in creation order
+         entries_index entries(_self, scope);
+         auto entriesByCreatedAt = entries.get_index<name("bycreatedat")>();
+
+         uint64_t entryCursor = get_archive_cursor(name("entries"), scope);
+         auto entryItr = entriesByCreatedAt.lower_bound(entryCursor);
+         while(spent < budget && entryItr != entriesByCreatedAt.end() && entryItr->createdAt + (24 * 60 * 60) <= now) {
+            entryCursor = entryItr->createdAt;
+
+            if (entryItr->contestId == 0 && entryItr->amount == 0) {
+               print("archive entry without contest ", entryItr->id, "\n");
+               dropEntryScope(entryItr->id);
+               entryItr = entriesByCreatedAt.erase(entryItr);
+               spent += archiveCostEntry;
+            } else {
+               entryItr++;
+               spent += archiveCostScan;
+            }
+         }
+
+         set_archive_cursor(name("entries"), scope, entryCursor);
+      }
+
+      /*
+         Reindex Legacy Entries - entries written before the byvideo index keep their secondary rows in
+         legacy_entries_index's layout: the bycreatedat sweeps can't see them & erasing them through
+         entries_index leaves those rows behind. Each is erased through the old layout & written again
+         through the current one. Returns false while some are left, the scope's sweeps wait until then.
+      */
+      bool reindexLegacyEntries(uint64_t scope, uint64_t budget, uint64_t& spent) {
+         legacy_entries_index legacyEntries(_self, scope);
+         auto legacyByCreatedAt = legacyEntries.get_index<name("bycreatedat")>();
+         auto legacyItr = legacyByCreatedAt.begin();
+         if (legacyItr == legacyByCreatedAt.end()) { return true; }
+
+         entries_index entries(_self, scope);
+         while(spent < budget && legacyItr != legacyByCreatedAt.end()) {
+            contestEntry row = *legacyItr;
+            print("reindex entry ", row.id, "\n");
+            legacyItr = legacyByCreatedAt.erase(legacyItr);
+            entries.emplace(_self, [&](contestEntry& newRow) {
+               newRow = row;
+               upgradeRow(newRow);
+            });
+
+            // the sweep cursors may already be past it
+            rewind_archive_cursor(name("entries"), scope, row.createdAt);
+            rewind_archive_cursor(name("refunds"), scope, row.createdAt);
+            spent += archiveCostReindex;
+         }
+         return legacyItr == legacyByCreatedAt.end();
+      }
+
+      /*
+         Erase the votes of a contest, returns false when the budget ran out first
+      */
+      bool archiveContestVotes(uint64_t scope, uint64_t contestId, uint64_t budget, uint64_t& spent) {
+         vote_index votes(_self, scope);
+         auto votesByContest = votes.get_index<name("byusrcontest")>();
+         auto voteItr = votesByContest.lower_bound(composite_key(contestId, 0));
+         while(voteItr != votesByContest.end() && voteItr->contestId == contestId) {
+            if (spent >= budget) { return false; }
+            print("archive vote ", voteItr->id, "\n");
+            voteItr = votesByContest.erase(voteItr);
+            spent += archiveCostVote;
+         }
+         return true;
+      }
+
+      /*
+         Erase a contest with its votes and entries, returns false when the budget ran out first
+      */
+      bool archiveContest(contest_index& contests, uint64_t contestId, uint64_t budget, uint64_t& spent) {
+         print("archiving contest ", contestId, "\n");
+
+         uint64_t scope = contests.get_scope();
+         if (!archiveContestVotes(scope, contestId, budget, spent)) {
+            return false;
+         }
+
+         entries_index entries(_self, scope);
+         auto entriesByContest = entries.get_index<name("bycontest")>();
+         auto entryItr = entriesByContest.lower_bound(contestId);
+         while(entryItr != entriesByContest.end() && entryItr->contestId == contestId) {
+            if (spent >= budget) { return false; }
+            print("archive entry ", entryItr->id, "\n");
+            dropEntryScope(entryItr->id);
+            entryItr = entriesByContest.erase(entryItr);
+            spent += archiveCostEntry;
+         }
+
+         if (spent >= budget) { return false; }
+         print("archive contest ", contestId, "\n");
+         contests.erase(contests.find(contestId));
+         emitEvent(name("evarchived"), contestId);
+         spent += archiveCostContest;
+         return true;
+      }
+
+      /*
+         Schema Versions - rows of versioned tables carry schemaVersion, rows written before it was
+         added read as version 0. Every write passes the row through upgradeRow first, rows that are
+         never written again are upgraded by the migrate action. A layout change bumps the version &
+         adds its conversion to the table's upgradeRow.
+      */
+      static constexpr uint8_t entrySchemaVersion = 1;
+      static constexpr uint8_t contestSchemaVersion = 1;
+      static constexpr uint8_t profileSchemaVersion = 1;
+      static constexpr uint8_t levelSchemaVersion = 1;
+      static constexpr uint64_t migrateCostRow = 2; // primary row rewritten, secondary keys unchanged
+      static constexpr uint64_t migrateCostReindex = 6; // primary + 2 secondary rows erased & written again
+
+      void upgradeRow(contestEntry& row) {
+         if (row.schemaVersion.value_or(0) >= entrySchemaVersion) { return; }
+         row.schemaVersion.emplace(entrySchemaVersion);
+      }
+
+      void upgradeRow(contest& row) {
+         if (row.schemaVersion.value_or(0) >= contestSchemaVersion) { return; }
+         row.schemaVersion.emplace(contestSchemaVersion);
+      }
+
+      // schemaVersion can only follow text, a plain text profile gets a zeroed proftext to carry it
+      void upgradeRow(profile& row) {
+         if (row.schemaVersion.value_or(0) >= profileSchemaVersion) { return; }
+         if (!row.text.has_value()) {
+            row.text.emplace(proftext{});
+         }
+         row.schemaVersion.emplace(profileSchemaVersion);
+      }
+
+      void upgradeRow(level& row) {
+         if (row.schemaVersion.value_or(0) >= levelSchemaVersion) { return; }
+         row.schemaVersion.emplace(levelSchemaVersion);
+      }
+
+      template<typename rowT>
+      static bool needsUpgrade(const rowT& row, uint8_t version) {
+         return row.schemaVersion.value_or(0) < version;
+      }
+
+      static constexpr uint64_t migrateCursorDone = ~uint64_t(0); // scope walked, wait for the others
+
+      template<typename tableT>
+      bool migrateScopes(name cursor, uint8_t version, const std::vector<uint64_t>& scopes, uint64_t budget) {
+         uint64_t spent = 0;
+         bool complete = true;
+         for (auto scope : scopes) {
+            tableT table(_self, scope);
+            complete = migrateRows(table, cursor, version, budget, spent) && complete;
+         }
+
+         phaseCompleted("migrateRows");
+
+         // every scope has been walked, the next call starts over
+         if (complete) {
+            for (auto scope : scopes) {
+               set_archive_cursor(cursor, scope, 0);
+            }
+         }
+         phaseCompleted("cursors");
+         return complete;
+      }
+
+      template<typename tableT, typename itrT>
+      itrT migrateRow(tableT& table, itrT itr, uint8_t version, uint64_t& spent) {
+         if (needsUpgrade(*itr, version)) {
+            table.modify(itr, _self, [&](auto& row) {
+               upgradeRow(row);
+            });
+            spent += migrateCostRow;
+         } else {
+            spent += archiveCostScan;
+         }
+         return ++itr;
+      }
+
+      // profiles stored before the byaccount index are written again, which adds their row to it
+      profile_index::const_iterator migrateRow(profile_index& profiles, profile_index::const_iterator itr, uint8_t version, uint64_t& spent) {
+         if (hasAccountIndexRow(profiles, *itr)) {
+            return migrateRow<profile_index, profile_index::const_iterator>(profiles, itr, version, spent);
+         }
+         spent += migrateCostReindex;
+         return ++rewriteProfile(profiles, itr);
+      }
+
+      template<typename tableT>
+      bool migrateRows(tableT& table, name cursor, uint8_t version, uint64_t budget, uint64_t& spent) {
+         uint64_t scope = table.get_scope();
+         uint64_t position = get_archive_cursor(cursor, scope);
+         if (position == migrateCursorDone) { return true; }
+
+         auto itr = table.lower_bound(position);
+         while(spent < budget && itr != table.end()) {
+            itr = migrateRow(table, itr, version, spent);
+         }
+
+         bool complete = itr == table.end();
+         set_archive_cursor(cursor, scope, complete ? migrateCursorDone : itr->primary_key());
+         print("migrate ", cursor, " cost spent: ", spent, " of ", budget, "\n");
+         return complete;
+      }
+
+      uint64_t get_archive_cursor(name phase, uint64_t scope) {
+         archcursor_index cursors(_self, scope);
+         auto cursorItr = cursors.find(phase.value);
+         if (cursorItr == cursors.end()) {
+            return 0;
+         }
+         return cursorItr->position;
+      }
+
+      void set_archive_cursor(name phase, uint64_t scope, uint64_t position) {
+         archcursor_index cursors(_self, scope);
+         auto cursorItr = cursors.find(phase.value);
+         if (cursorItr == cursors.end()) {
+            // a missing cursor reads as 0, so idle scopes don't get rows
+            if (position == 0) { return; }
+            cursors.emplace(_self, [&](archcursor& row) {
+               row.id = phase;
+               row.position = position;
+            });
+         } else if (cursorItr->position != position) {
+            cursors.modify(cursorItr, _self, [&](archcursor& row) {
+               row.position = position;
+            });
+         }
+      }
+
+      /*
+         Move a phase cursor back so rows that became archivable behind it are swept again
+      */
+      void rewind_archive_cursor(name phase, uint64_t scope, uint64_t position) {
+         if (position < get_archive_cursor(phase, scope)) {
+            set_archive_cursor(phase, scope, position);
+         }
+      }
+
+      bool checkusername(std::string username) {
+         print("checkusername ", username, "\n");
+
+         // cannot be under 6 char
+         if (username.size() < 6) {
+            print("Username cannot be less than 6 characters.", "\n");
+            return false;
+         }
+
+         // cannot be over 30 char
+         if (username.size() > 30) {
+            print("Username cannot be more than 30 characters.", "\n");
+            return false;
+         }
+
+         // prevent starting with dot
+         if (username.front() == '.') {
+            print("Username cannot start with a dot.", "\n");
+            return false;
+         }
+
+         // prevent ending with dot
+         if (username.back() == '.') {
+            print("Username cannot end with a dot.", "\n");
+            return false;
+         }
+
+         // only allow alphanumeric and dots (A-Z a-z 0-9 .)
+
+         char *prevChar = NULL;
+         for (char &c: username) {
+            if (!isUsernameChar(c)) {
+               print("Username is limited to containing alphanumeric(A-Z a-z 0-9) and dots(.).", "\n");
+               return false;
+            }
+
+            if (c == '.' && *prevChar == '.') {
+               print("Username cannot contain double dots (..).", "\n");
+               return false;
+            }
+            prevChar = &c;
+         }
+
+         print("username is valid", "\n");
+         return true;
+      }
+
+      static uint128_t composite_key(uint64_t mostSignificantInt, uint64_t leastSignificantInt) {
+         return (uint128_t) mostSignificantInt << 64 | leastSignificantInt;
+      }
+
+      static checksum256 composite_key(uint64_t a, uint64_t b, uint64_t c) {
+         return checksum256::make_from_word_sequence<uint64_t>(
+            0ULL, a, b, c
+         );
+      }
+
+      /*
+         Close Open Entry - closes the user's open entry for the level in a scope, rejecting the new one while the
+         open entry's contest hasn't started voting
+      */
+      void closeOpenEntry(uint64_t scope, const contestargs& params, uint32_t now) {
+         entries_index entries(_self, scope);
+         contest_index contests(_self, scope);
+
+         auto byUserIdAndLevelIdIdx = entries.get_index<name("byuserandlvl")>();         
+         auto itr = byUserIdAndLevelIdIdx.find(composite_key(params.userId.value, params.levelId.value, true));
+
+         // 1. get by index with UserId, LevelId, and open = 1
+         // 2. check if is actually open or not, mark open = 0 if so
+         if(itr != byUserIdAndLevelIdIdx.end() && itr->contestId > 0) {
+            auto contestItr = contests.find(itr->contestId);
+            if (contestItr != contests.end()) {
+               check(now > contestItr->votestarttime(), "You've already entered this contest. You can only submit one entry per contest. (entryId: " + params.id.to_string() + ")");
+
+               byUserIdAndLevelIdIdx.modify(itr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
+                  row.open = false;
+               });
+            }
+         } else if(itr != byUserIdAndLevelIdIdx.end()) {
+            byUserIdAndLevelIdIdx.modify(itr, _self, [&](contestEntry& row) {
+               upgradeRow(row);
+               row.open = false;
+            });
+         }
+      }
+
+      /*
+         Video Fingerprint - 64 bits of both video hashes for the byvideo index, the second rotated so equal
+         hashes don't cancel out. 0 when neither hash is set.
+      */
+      static uint64_t videoFingerprint(const checksum256& hash720p, const checksum256& hash1080p) {
+         uint64_t sm = uint64_t(hash720p.get_array()[0]);
+         uint64_t lg = uint64_t(hash1080p.get_array()[0]);
+         return sm ^ (lg << 32 | lg >> 32);
+      }
+
+      /*
+         Video Holder - the paid entry in the category that holds a video, empty when there is none. Fingerprint
+         matches are confirmed against the full hashes. Unpaid entries don't hold their video, so an entry nobody
+         pays for can't keep others from entering it; the first one paid takes it.
+      */
+      name videoHolder(entries_index& entries, name entryId, const checksum256& hash720p, const checksum256& hash1080p) {
+         uint64_t fingerprint = videoFingerprint(hash720p, hash1080p);
+         if (fingerprint == 0 && hash720p == checksum256() && hash1080p == checksum256()) {
+            return name();
+         }
+
+         auto byVideoIdx = entries.get_index<name("byvideo")>();
+         for (auto itr = byVideoIdx.lower_bound(fingerprint); itr != byVideoIdx.end() && itr->byvideo() == fingerprint; itr++) {
+            if (itr->videoHash720p != hash720p || itr->videoHash1080p != hash1080p) {
+               continue;
+            }
+            if (itr->contestId == 0 || itr->id == entryId) {
+               continue;
+            }
+            return itr->id;
          }
+         return name();
+      }
+
+      void checkVideoUnique(entries_index& entries, const contestargs& params) {
+         name holder = videoHolder(entries, params.id, params.videoHash720p, params.videoHash1080p);
+         check(holder == name(), "This video has already been entered. (entryId: " + holder.to_string() + ")");
       }
 
       /*
-         Archive Contests
+         Multi-entry memo - "entries:<entry id>=<amount>,<entry id>=<amount>" with amounts written in the
+         transfer's precision, e.g. "entries:alice1=1.5000,alice2=0.5000". Parsed in place; every id must be
+         unique & the amounts must add up to the transferred quantity.
       */
-      void archiveContests() {
-         contest_index contests( _self, _self.value );
-         auto contestsByEndtime = contests.get_index<name("byendtime")>();
+      static constexpr const char* entriesMemoPrefix = "entries:";
 
-         vote_index votes(_self, _self.value);
-         auto votesByEntry = votes.get_index<name("byentryid")>();
+      std::vector<std::pair<name, int64_t>> parseEntriesMemo(std::string_view memo, const asset& quantity) {
+         std::vector<std::pair<name, int64_t>> funding;
+         safeint total = 0;
 
-         entries_index entries(_self, _self.value);
-         auto entriesByContest = entries.get_index<name("bycontest")>();
-         auto entriesByCreatedAt = entries.get_index<name("bycreatedat")>();
+         while (memo.size() > 0) {
+            size_t partEnd = std::min(memo.find(','), memo.size());
+            std::string_view part = memo.substr(0, partEnd);
+            memo.remove_prefix(std::min(partEnd + 1, memo.size()));
 
-         uint64_t now = eosio::current_time_point().sec_since_epoch();
-         uint64_t archSec = get_option_int(name{"entryarchsec"});
+            size_t separator = part.find('=');
+            check(separator != std::string_view::npos && separator > 0, "Invalid entries memo, expected <entry id>=<amount>");
 
-         int limitIndex = 0;
-         int limitMax = 500;
-         auto contestItr = contestsByEndtime.begin();
-         while(contestItr != contestsByEndtime.end() && limitIndex < limitMax && now > contestItr->endtime() + archSec) {
-            if (!contestItr->paid) continue;
-
-            print("archiving contest ", contestItr->id, "\n");
-            auto entryItr = entriesByContest.lower_bound(contestItr->id);
-
-            while(entryItr != entriesByContest.end() && limitIndex < limitMax && entryItr->contestId == contestItr->id) {
-               print("archiving entry ", entryItr->id, "\n");
-
-               auto voteItr = votesByEntry.lower_bound(entryItr->id.value);
-               while(voteItr != votesByEntry.end() && limitIndex < limitMax && voteItr->entryId == entryItr->id) {
-                  print("archive vote ", voteItr->id, "\n");
-                  voteItr = votesByEntry.erase(voteItr);
-                  limitIndex++;
-               }
+            name entryId = name(part.substr(0, separator));
+            int64_t amount = parseMemoAmount(part.substr(separator + 1), quantity.symbol.precision());
+            check(amount > 0, "Invalid entries memo, amount must be positive");
 
-               if (limitIndex < limitMax) {
-                  print("archive entry ", entryItr->id, "\n");
-                  entryItr = entriesByContest.erase(entryItr);
-                  limitIndex++;
-               }
+            for (auto const& existing : funding) {
+               check(existing.first != entryId, "Invalid entries memo, duplicate entry: " + entryId.to_string());
             }
 
-            if (limitIndex < limitMax) {
-               print("archive contest ", contestItr->id, "\n");
-               contestItr = contestsByEndtime.erase(contestItr);
-               limitIndex++;
-            }
+            funding.push_back(std::make_pair(entryId, amount));
+            total = total + safeint{amount};
          }
 
-         auto entryItr2 = entriesByContest.begin();
-         while(entryItr2 != entriesByContest.end() && entryItr2->contestId == 0 && limitIndex < limitMax && entryItr2->createdAt + (24 * 60 * 60) <= now) {
-            if (entryItr2->contestId == 0 && entryItr2->amount == 0) {
-               print("archive entry without contest ", entryItr2->id, "\n");
-               entryItr2 = entriesByContest.erase(entryItr2);
-               limitIndex++;
-            } else {
-               entryItr2++;
-            }
-         }
+         check(funding.size() > 0, "Invalid entries memo, no entries");
+         check(total.amount == quantity.amount, "Entry amounts do not add up to the transferred quantity");
+         return funding;
       }
 
-      bool checkusername(std::string username) {
-         print("checkusername ", username, "\n");
+      // "1.5" or "1.5000" at precision 4 -> 15000
+      int64_t parseMemoAmount(std::string_view str, uint8_t precision) {
+         check(str.size() > 0, "Invalid entries memo, missing amount");
 
-         // cannot be under 6 char
-         if (username.size() < 6) {
-            print("Username cannot be less than 6 characters.", "\n");
-            return false;
+         int64_t amount = 0;
+         int32_t decimals = -1;
+         for (char c : str) {
+            if (c == '.' && decimals < 0) {
+               decimals = 0;
+               continue;
+            }
+            check(c >= '0' && c <= '9', "Invalid entries memo, bad amount");
+            check(decimals < precision, "Invalid entries memo, too many decimals");
+            check(amount <= (asset::max_amount - 9) / 10, "Invalid entries memo, amount too large");
+            amount = amount * 10 + (c - '0');
+            if (decimals >= 0) {
+               decimals++;
+            }
          }
 
-         // cannot be over 30 char
-         if (username.size() > 30) {
-            print("Username cannot be more than 30 characters.", "\n");
-            return false;
+         for (int32_t i = std::max(decimals, 0); i < precision; i++) {
+            check(amount <= asset::max_amount / 10, "Invalid entries memo, amount too large");
+            amount *= 10;
          }
+         return amount;
+      }
 
-         // prevent starting with dot
-         if (username.front() == '.') {
-            print("Username cannot start with a dot.", "\n");
-            return false;
+      /*
+         Activation Context - options, levels & price highs read once and shared by every entry
+         activated in the same action
+      */
+      struct activationContext {
+         uint32_t now;
+         uint64_t entryexp;
+         uint64_t pricefresh;
+         std::vector<levelrule> levels;
+         bool pricesLoaded = false;
+         uint64_t pricesFrom = 0;
+         bool freshPrice = false;
+         std::vector<std::pair<uint64_t, uint32_t>> priceHighs; // end time, highest usdHigh from that end time on
+      };
+
+      activationContext getActivationContext() {
+         activationContext ctx;
+         ctx.now = eosio::current_time_point().sec_since_epoch();
+         ctx.entryexp = get_option_int(name{"entryexp"});
+         ctx.pricefresh = get_option_int(name{"pricefresh"});
+         return ctx;
+      }
+
+      // pointer is valid until the next lookup
+      const levelrule* findLevel(activationContext& ctx, name levelId) {
+         for (auto const& cached : ctx.levels) {
+            if (cached.id == levelId) {
+               return &cached;
+            }
          }
 
-         // prevent ending with dot
-         if (username.back() == '.') {
-            print("Username cannot end with a dot.", "\n");
-            return false;
+         levelrule rule = getLevelRule(levelId);
+         if (rule.id != levelId) {
+            return nullptr;
          }
+         ctx.levels.push_back(rule);
+         return &ctx.levels.back();
+      }
 
-         // only allow alphanumeric and dots (A-Z a-z 0-9 .)
-         std::map<char, char> allowedCharactersHash({
-            {'a', 'a'}, {'b', 'b'}, {'c', 'c'}, {'d', 'd'}, {'e', 'e'}, {'f', 'f'}, {'g', 'g'}, {'h', 'h'},
-            {'i', 'i'}, {'j', 'j'}, {'k', 'k'}, {'l', 'l'}, {'m', 'm'}, {'n', 'n'}, {'o', 'o'}, {'p', 'p'},
-            {'q', 'q'}, {'r', 'r'}, {'s', 's'}, {'t', 't'}, {'u', 'u'}, {'v', 'v'}, {'w', 'w'}, {'x', 'x'},
-            {'y', 'y'}, {'z', 'z'}, {'A', 'A'}, {'B', 'B'}, {'C', 'C'}, {'D', 'D'}, {'E', 'E'}, {'F', 'F'},
-            {'G', 'G'}, {'H', 'H'}, {'I', 'I'}, {'J', 'J'}, {'K', 'K'}, {'L', 'L'}, {'M', 'M'}, {'N', 'N'},
-            {'O', 'O'}, {'P', 'P'}, {'Q', 'Q'}, {'R', 'R'}, {'S', 'S'}, {'T', 'T'}, {'U', 'U'}, {'V', 'V'},
-            {'W', 'W'}, {'X', 'X'}, {'Y', 'Y'}, {'Z', 'Z'}, {'1', '1'}, {'2', '2'}, {'3', '3'}, {'4', '4'},
-            {'5', '5'}, {'6', '6'}, {'7', '7'}, {'8', '8'}, {'9', '9'}, {'0', '0'}, {'.', '.'}
-         });
+      /*
+         Highest usdHigh of the prices ending at or after createdAt. The price rows are scanned once,
+         from the oldest createdAt asked for, into suffix maximums.
+      */
+      uint32_t priceHighSince(activationContext& ctx, uint64_t createdAt) {
+         if (!ctx.pricesLoaded || createdAt < ctx.pricesFrom) {
+            curprice_index curprices(_self, _self.value);
+            auto pricesByEndTime = curprices.get_index<name("byendtime")>();
 
-         char *prevChar = NULL;
-         for (char &c: username) {
-            if (allowedCharactersHash.count(c) == 0) {
-               print("Username is limited to containing alphanumeric(A-Z a-z 0-9) and dots(.).", "\n");
-               return false;
+            ctx.priceHighs.clear();
+            for (auto itr = pricesByEndTime.lower_bound(createdAt); itr != pricesByEndTime.end(); itr++) {
+               ctx.priceHighs.push_back(std::make_pair(itr->endtime_key(), itr->usdHigh));
+            }
+            for (size_t i = ctx.priceHighs.size(); i > 1; i--) {
+               ctx.priceHighs[i - 2].second = std::max(ctx.priceHighs[i - 2].second, ctx.priceHighs[i - 1].second);
             }
 
-            if (c == '.' && *prevChar == '.') {
-               print("Username cannot contain double dots (..).", "\n");
-               return false;
+            // mark entry as priceUnavailable if lastest currency price openTime + intervalSec is older than the set required price freshness
+            ctx.freshPrice = false;
+            if (pricesByEndTime.begin() != pricesByEndTime.end()) {
+               auto lastPrice = --pricesByEndTime.end();
+               ctx.freshPrice = (safeint{lastPrice->openTime} + safeint{lastPrice->intervalSec} + safeint{ctx.pricefresh}).amount > ctx.now;
             }
-            prevChar = &c;
-         }
 
-         print("username is valid", "\n");
-         return true;
-      }
+            ctx.pricesLoaded = true;
+            ctx.pricesFrom = createdAt;
+         }
 
-      static uint128_t composite_key(uint64_t mostSignificantInt, uint64_t leastSignificantInt) {
-         return (uint128_t) mostSignificantInt << 64 | leastSignificantInt;
+         auto highItr = std::lower_bound(ctx.priceHighs.begin(), ctx.priceHighs.end(), std::make_pair(createdAt, uint32_t(0)));
+         return highItr == ctx.priceHighs.end() ? 0 : highItr->second;
       }
 
-      static checksum256 composite_key(uint64_t a, uint64_t b, uint64_t c) {
-         return checksum256::make_from_word_sequence<uint64_t>(
-            0ULL, a, b, c
-         );
+      // currency still to be paid for a contest price in cents, rounded up so the top-up is always enough
+      uint64_t amountOwed(uint64_t contestPrice, uint64_t priceHigh, uint64_t paid) {
+         if (priceHigh == 0) {
+            return 0;
+         }
+         uint64_t needed = (safeint{contestPrice} * 1000000 + safeint{priceHigh} - 1) / safeint{priceHigh};
+         return needed > paid ? needed - paid : 0;
       }
 
       template <typename entriesT, typename entryItrT>
-      bool activateEntry(entriesT& entries, entryItrT& entryItr) {      
+      bool activateEntry(entriesT& entries, entryItrT& entryItr, uint64_t scope, activationContext& ctx, entrystatus& result) {
          print("activate entry \n");
+         result = entrystatus{};
+         result.status = name("invalid");
          if(entryItr == entries.end()) {
             print("Cannot activate entry: invalid entry");
             return false;
          }
+         result.entryId = entryItr->id;
 
          // ensure entry is not closed
          if(!entryItr->open) {
             print("Cannot activate entry: entry is closed.\n");
+            result.status = name("closed");
             return false;
          }
 
          // ensure entry is already assigned to contest
          if(entryItr->contestId != 0) {
             print("Entry already paid & assigned to contest.\n");
+            contest_index contests(_self, scope);
+            result.status = name("active");
+            result.contestId = entryItr->contestId;
+            result.voteStart = contests.get(entryItr->contestId, "Contest not found").votestarttime();
             return false;
          }
 
-         uint32_t now = eosio::current_time_point().sec_since_epoch();
+         uint32_t now = ctx.now;
 
          // ensure entry is not expired
-         uint64_t entryexpTime = get_option_int(name{"entryexp"});
-
-         if (now > (safeint{entryItr->createdAt} + safeint{entryexpTime}).amount) {
+         if (now > (safeint{entryItr->createdAt} + safeint{ctx.entryexp}).amount) {
             print("Entry is expired, please initiate refund to recieve money back.\n");
             entries.modify(entryItr, _self, [&](contestEntry& row) {
+               upgradeRow(row);
                row.priceUnavailable = false;
             });
+            result.status = name("expired");
             return false;
          }
 
-         // get level interator
-         level_index levels(_self, _self.value);
-         auto levelItr = levels.find(entryItr->levelId.value);
+         // get level
+         const levelrule* levelItr = findLevel(ctx, entryItr->levelId);
 
-         if (levelItr == levels.end()) {
+         if (levelItr == nullptr) {
             print("Error Creating Contest: could not find level with that id.", "\n");
             return false;
          }
 
-         // get contest interator
-         contest_index contests(_self, _self.value);
+         return withPayout(levelItr->flags & levelRuleFixedPrize, [&](auto payout) {
+            return joinContest<decltype(payout)>(entries, entryItr, scope, ctx, *levelItr, result);
+         });
+      }
+
+      /*
+         Join Contest - the activation of an open, unexpired entry, instantiated per payout policy. Joins the
+         level's current contest or opens the next one.
+      */
+      template <typename payoutT, typename entriesT, typename entryItrT>
+      bool joinContest(entriesT& entries, entryItrT& entryItr, uint64_t scope, activationContext& ctx, const levelrule& level, entrystatus& result) {
+         uint32_t now = ctx.now;
+         const levelrule* levelItr = &level;
+
+         // get contest interator, contests share the scope of their entries
+         contest_index contests(_self, scope);
          auto byLevelIdx = contests.get_index<name("bylevel")>();
          uint64_t submissionsClosed = false;
          auto curContestItr = byLevelIdx.lower_bound(composite_key(entryItr->levelId.value, submissionsClosed));
@@ -1379,7 +2617,7 @@ class [[eosio::contract("flair")]] flair : public contract {
             contestPrice = curContestItr->price;
          } else {
             contestPrice = levelItr->price;
-            if (levelItr->fixedPrize > 0) {
+            if constexpr (payoutT::usesPrizeFund) {
                auto prizefund = get_option_int(name{"prizefund"});
                check(prizefund >= usdToCurrencyAmount(levelItr->fixedPrize), "Not enough money in prize fund to pay out prize.");
             }
@@ -1387,86 +2625,98 @@ class [[eosio::contract("flair")]] flair : public contract {
          print("ae: test2");
          if (contestPrice != 0) {
             // determine eos price high since entry created
-            curprice_index curprices(_self, _self.value);
-            auto pricesByEndTime = curprices.get_index<name("byendtime")>();
-            auto priceItr = pricesByEndTime.lower_bound(entryItr->createdAt);
-
-            uint64_t priceHigh = 0;
-
-            for (auto itr = priceItr; itr != pricesByEndTime.end(); itr++) {
-               print("debug price high: ", itr->usdHigh, "\n");
-               if(itr->usdHigh > priceHigh) {
-                  priceHigh = itr->usdHigh;
-               }
-            }
+            uint64_t priceHigh = priceHighSince(ctx, entryItr->createdAt);
+            print("price high debug: priceHigh=", priceHigh, " freshPrice=", ctx.freshPrice, "\n");
+            result.priceHigh = priceHigh;
 
-            // mark entry as priceUnavailable if lastest currency price openTime + intervalSec is older than the set required price freshness
-            uint64_t freshTime = get_option_int(name{"pricefresh"});
-            auto lastPrice = --pricesByEndTime.end();
-
-            bool freshPrice = (safeint{lastPrice->openTime} + safeint{lastPrice->intervalSec} + safeint{freshTime}).amount > now;
-            print(
-               "price fresh debug: freshPrice=", freshPrice,
-               " lastEndTime=", (safeint{lastPrice->openTime} + safeint{lastPrice->intervalSec}).amount, 
-               ", freshTime=", freshTime, " | ", (safeint{lastPrice->openTime} + safeint{lastPrice->intervalSec} + safeint{freshTime}).amount, " > ", now, 
-               "\n"
-            );
-            if(priceHigh <= 0 || !freshPrice) {
+            if(priceHigh <= 0 || !ctx.freshPrice) {
                entries.modify(entryItr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
                   row.priceUnavailable = true;
                });
 
                print("Currency Price Unavailable: run update action to recheck once price has been updated.\n");
+               result.status = name("priceunavail");
                return false;
             }
 
             // fail if quantity is not enough
             print("debug price 1: ", priceHigh, " ", entryItr->amount, " ", contestPrice, "\n");
             // paid in cents
-            auto paidAmt = (safeint{priceHigh} * safeint{entryItr->amount} / 1000000.0).amount;
+            uint64_t paidAmt = (safeint{priceHigh} * safeint{entryItr->amount} / 1000000.0).amount;
             print("debug price 2: paidAmt: ¢", paidAmt, ", contestPrice: ¢", contestPrice, "\n");
             if (paidAmt < contestPrice) {
                print("Payment not enough only ¢", paidAmt,".\n");
+               result.status = name("underpaid");
+               result.amountOwed = amountOwed(contestPrice, priceHigh, entryItr->amount);
                return false;
             }
          }
 
+         // another entry of the video may have been paid first, the payment stays refundable
+         entries_index scopeEntries(_self, scope);
+         name videoHeldBy = videoHolder(scopeEntries, entryItr->id, entryItr->videoHash720p, entryItr->videoHash1080p);
+         if (videoHeldBy != name()) {
+            print("Video already entered by ", videoHeldBy, "\n");
+            if (entryItr->priceUnavailable) {
+               entries.modify(entryItr, _self, [&](contestEntry& row) {
+                  upgradeRow(row);
+                  row.priceUnavailable = false;
+               });
+            }
+            result.status = name("duplicate");
+            return false;
+         }
+
          if (curContestValid) {
             entries.modify(entryItr, _self, [&](contestEntry& row) {
+               upgradeRow(row);
                row.contestId = curContestItr->id;
                row.priceUnavailable = false;
             });
             byLevelIdx.modify(curContestItr, _self, [&](contest& row) {
+               upgradeRow(row);
                row.participantCount++;
+               withSchedule(row, [&](auto schedule) { decltype(schedule)::entryAdded(row, now); });
+            });
 
-               if (row.minParticipant == row.participantCount && now > row.createdAt + row.submissionPeriod) {
-                  row.lastEntryAddedAt = now;
-               }
+            emitEvent(name("evactivate"), entryItr->id, entryItr->userId, curContestItr->id);
+            if (withSchedule(*curContestItr, [&](auto schedule) { return decltype(schedule)::voteStartReached(*curContestItr); })) {
+               emitEvent(name("evvotestart"), curContestItr->id, curContestItr->votestarttime(), curContestItr->endtime());
+            }
+            if (curContestItr->participantCount == curContestItr->participantLimit) {
+               emitEvent(name("evfull"), curContestItr->id);
+            }
+
+            updateProfStats(entryItr->userId, [&](profstat& row) {
+               row.entries++;
             });
 
-            
+            result.status = name("active");
+            result.contestId = curContestItr->id;
+            result.voteStart = curContestItr->votestarttime();
 
             print(entryItr->id, " activated with contest id of ", curContestItr->id, "\n");
             return true;
          } else {
-            uint32_t levelContestCount = countOpenContestForLevel(entryItr->levelId);
+            uint32_t levelContestCount = countOpenContestForLevel(*levelItr);
             print("levelAllowedSimultaneousContests:", levelItr->allowedSimultaneousContests, "\n");
             print("levelContestCount:", levelContestCount, "\n");
             check(levelItr->allowedSimultaneousContests == 0 || levelContestCount < levelItr->allowedSimultaneousContests, "This level is full");
 
             safeint levelFixedPrizeCurrency = 0;
-            if (levelItr->fixedPrize > 0) {
+            if constexpr (payoutT::usesPrizeFund) {
                auto prizefund = get_option_int(name{"prizefund"});
                levelFixedPrizeCurrency = usdToCurrencyAmount(levelItr->fixedPrize);
                prizefund = (safeint{prizefund} - levelFixedPrizeCurrency).amount;
                set_option(name{"prizefund"}, prizefund);
             }
 
-            uint64_t newContestId = contests.available_primary_key();
-            if (newContestId == 0) { newContestId++; }
+            uint64_t newContestId = nextContestId();
             print("newContestId: ", newContestId, "\n");
             
-            contests.emplace(_self, [&](contest& row) {
+            auto newContestItr = contests.emplace(_self, [&](contest& row) {
+               upgradeRow(row);
                row.id = newContestId;
                row.levelId = entryItr->levelId;
                row.participantLimit = levelItr->participantLimit;
@@ -1480,23 +2730,40 @@ class [[eosio::contract("flair")]] flair : public contract {
                row.voteStartUTCHour = levelItr->voteStartUTCHour;
                row.paid = false;
                row.minParticipant = levelItr->minParticipant;
-
-               if (row.minParticipant == row.participantCount && now > row.createdAt + row.submissionPeriod) {
-                  row.lastEntryAddedAt = now;
-               }
+               withSchedule(row, [&](auto schedule) { decltype(schedule)::entryAdded(row, now); });
             });
 
             if(curContestItr != byLevelIdx.end()) {
                byLevelIdx.modify(curContestItr, _self, [&](contest& row) {
+                  upgradeRow(row);
                   row.submissionsClosed = 1;
                });
+               emitEvent(name("evclosed"), curContestItr->id);
             }
 
             entries.modify(entryItr, _self, [&](contestEntry& row) {
+               upgradeRow(row);
                row.contestId = newContestId;
                row.priceUnavailable = false;
             });
 
+            emitEvent(name("evcreated"), newContestId, newContestItr->levelId, newContestItr->participantLimit, newContestItr->createdAt);
+            emitEvent(name("evactivate"), entryItr->id, entryItr->userId, newContestId);
+            if (withSchedule(*newContestItr, [&](auto schedule) { return decltype(schedule)::voteStartReached(*newContestItr); })) {
+               emitEvent(name("evvotestart"), newContestId, newContestItr->votestarttime(), newContestItr->endtime());
+            }
+            if (newContestItr->participantLimit == 1) {
+               emitEvent(name("evfull"), newContestId);
+            }
+
+            updateProfStats(entryItr->userId, [&](profstat& row) {
+               row.entries++;
+            });
+
+            result.status = name("active");
+            result.contestId = newContestId;
+            result.voteStart = newContestItr->votestarttime();
+
             print(entryItr->id, " activated with contest id of ", newContestId, "\n");
             return true;
          }
@@ -1511,6 +2778,191 @@ class [[eosio::contract("flair")]] flair : public contract {
          return (safeint{usd} * 1000000) / safeint{priceItr->usdHigh};
       }
 
+      /*
+         Level Rules - levels created before levelrules existed get their row the first time a hot path
+         looks them up. Their values were never validated, so they are clamped instead of checked: one bad
+         legacy level must not make update fail for every contest.
+      */
+      levelrule getLevelRule(name levelId) {
+         levelrule_index levelrules(_self, _self.value);
+         auto ruleItr = levelrules.find(levelId.value);
+         if (ruleItr != levelrules.end()) {
+            return *ruleItr;
+         }
+
+         level_index levels(_self, _self.value);
+         auto levelItr = levels.find(levelId.value);
+         if (levelItr == levels.end()) {
+            return levelrule{};
+         }
+
+         ruleItr = levelrules.emplace(_self, [&](levelrule& row) {
+            fillLevelRule(row, *levelItr);
+         });
+         return *ruleItr;
+      }
+
+      void syncLevelRule(const level& lvl) {
+         check(lvl.fee < 1000, "interval error: fee is too large, must be below 100%");
+         check(lvl.voteStartUTCHour < 24, "voteStartUTCHour must be below 24");
+         uint64_t prizeTotal = 0;
+         for (auto weight : lvl.prizes) {
+            prizeTotal += weight;
+         }
+         check(prizeTotal <= std::numeric_limits<uint32_t>::max(), "Prize weights add up to more than 32 bits");
+
+         levelrule_index levelrules(_self, _self.value);
+         auto ruleItr = levelrules.find(lvl.id.value);
+         if (ruleItr == levelrules.end()) {
+            levelrules.emplace(_self, [&](levelrule& row) {
+               fillLevelRule(row, lvl);
+            });
+         } else {
+            levelrules.modify(ruleItr, _self, [&](levelrule& row) {
+               fillLevelRule(row, lvl);
+            });
+         }
+      }
+
+      static void fillLevelRule(levelrule& row, const level& lvl) {
+         row.id = lvl.id;
+         row.categoryId = lvl.categoryId;
+         row.flags = 0;
+         if (lvl.archived) { row.flags |= levelRuleArchived; }
+         if (lvl.price == 0) { row.flags |= levelRuleFree; }
+         if (lvl.fixedPrize > 0) { row.flags |= levelRuleFixedPrize; }
+         row.voteStartUTCHour = std::min<uint32_t>(lvl.voteStartUTCHour, 23);
+         row.fee = std::min<uint32_t>(lvl.fee, 1000);
+         row.price = lvl.price;
+         row.fixedPrize = lvl.fixedPrize;
+         row.participantLimit = lvl.participantLimit;
+         row.allowedSimultaneousContests = lvl.allowedSimultaneousContests;
+         row.submissionPeriod = lvl.submissionPeriod;
+         row.votePeriod = lvl.votePeriod;
+         row.minParticipant = lvl.minParticipant;
+
+         row.prizeSums.clear();
+         uint64_t sum = 0;
+         for (auto weight : lvl.prizes) {
+            sum = std::min<uint64_t>(sum + weight, std::numeric_limits<uint32_t>::max());
+            row.prizeSums.push_back(uint32_t(sum));
+         }
+      }
+
+      /*
+         Account & active status used by permission checks. Profiles created before the
+         profauths table get their row from the full profile the first time they are used.
+      */
+      profauth getProfileAuth(name profileId) {
+         profauth_index profauths(_self, _self.value);
+         auto authItr = profauths.find(profileId.value);
+         if (authItr != profauths.end()) {
+            return *authItr;
+         }
+
+         profile_index profiles(_self, _self.value);
+         auto profileItr = profiles.find(profileId.value);
+         if (profileItr == profiles.end()) {
+            return profauth{};
+         }
+
+         authItr = profauths.emplace(_self, [&](profauth& row) {
+            row.id = profileItr->id;
+            row.account = profileItr->account;
+            row.active = profileItr->active;
+            row.flags = profileItr->winnings.amount > 0 ? profAuthLegacyWinnings : 0;
+         });
+         return *authItr;
+      }
+
+      void syncProfileAuth(name profileId, name account, bool active) {
+         profauth current = getProfileAuth(profileId);
+         if (current.account == account && current.active == active) {
+            return;
+         }
+
+         profauth_index profauths(_self, _self.value);
+         auto authItr = profauths.find(profileId.value);
+         profauths.modify(authItr, _self, [&](profauth& row) {
+            row.account = account;
+            row.active = active;
+         });
+      }
+
+      /*
+         Winnings live in the balances table; profile.winnings is only read for profiles
+         that have not been paid or charged since the table was introduced.
+      */
+      asset getWinnings(name profileId) {
+         balance_index balances(_self, _self.value);
+         auto balanceItr = balances.find(profileId.value);
+         if (balanceItr != balances.end()) {
+            return balanceItr->winnings;
+         }
+
+         profauth_index profauths(_self, _self.value);
+         auto authItr = profauths.find(profileId.value);
+         if (authItr != profauths.end() && (authItr->flags & profAuthLegacyWinnings) == 0) {
+            return asset{};
+         }
+
+         profile_index profiles(_self, _self.value);
+         auto profileItr = profiles.find(profileId.value);
+         if (profileItr == profiles.end()) {
+            return asset{};
+         }
+         return profileItr->winnings;
+      }
+
+      void addWinnings(name profileId, asset amount) {
+         uint32_t now = eosio::current_time_point().sec_since_epoch();
+         balance_index balances(_self, _self.value);
+         auto balanceItr = balances.find(profileId.value);
+
+         if (balanceItr == balances.end()) {
+            asset winnings = getWinnings(profileId);
+            if (winnings.amount > 0) {
+               winnings += amount;
+            } else {
+               winnings = amount;
+            }
+
+            balances.emplace(_self, [&](balance& row) {
+               row.id = profileId;
+               row.winnings = winnings;
+               row.updatedAt = now;
+            });
+         } else {
+            balances.modify(balanceItr, _self, [&](balance& row) {
+               row.winnings += amount;
+               row.updatedAt = now;
+            });
+         }
+      }
+
+      /*
+         Profile Stats - running totals per profile, kept apart from entries so they outlive archival
+      */
+      template<typename Func>
+      void updateProfStats(name profileId, Func&& update) {
+         profstat_index profstats(_self, _self.value);
+         auto statItr = profstats.find(profileId.value);
+
+         if (statItr == profstats.end()) {
+            profstats.emplace(_self, [&](profstat& row) {
+               row.id = profileId;
+               row.entries = 0;
+               row.contestsWon = 0;
+               row.votesReceived = 0;
+               row.winnings = asset{};
+               row.revocations = 0;
+               update(row);
+            });
+         } else {
+            profstats.modify(statItr, _self, update);
+         }
+      }
+
       void set_option(name id, std::string value) {
          option_index options(_self, _self.value);
          auto optionItr = options.find(id.value);
@@ -1527,7 +2979,7 @@ class [[eosio::contract("flair")]] flair : public contract {
       }
 
       void set_option(name id, uint64_t value) {
-         set_option(id, std::to_string(value));
+         set_option(id, encodeUint(value));
       }
 
       std::string get_option(name id) {
@@ -1543,7 +2995,31 @@ class [[eosio::contract("flair")]] flair : public contract {
       uint64_t get_option_int(name id) {
          std::string str = get_option(id);
          if (str == "") { return 0; }
-         return std::stoi(str);
+         return decodeUint(str);
+      }
+
+      /*
+         Option integers are stored as decimal text
+      */
+      static std::string encodeUint(uint64_t value) {
+         char digits[20];
+         size_t start = sizeof(digits);
+         do {
+            digits[--start] = '0' + value % 10;
+            value /= 10;
+         } while (value > 0);
+         return std::string(digits + start, sizeof(digits) - start);
+      }
+
+      static uint64_t decodeUint(const std::string& str) {
+         uint64_t value = 0;
+         for (char c : str) {
+            check(c >= '0' && c <= '9', "Option is not a number: " + str);
+            uint64_t digit = c - '0';
+            check(value <= (UINT64_MAX - digit) / 10, "Option number is too large: " + str);
+            value = value * 10 + digit;
+         }
+         return value;
       }
 
       void htmlspecialchars(std::string& data) {
@@ -1562,7 +3038,7 @@ class [[eosio::contract("flair")]] flair : public contract {
          data.swap(buffer);
       }
 
-      void checkAndSanitizeLink(std::string& data) {
+      void checkLink(const std::string& data) {
          if (data.length() == 0) { 
             return; 
          }
@@ -1570,70 +3046,193 @@ class [[eosio::contract("flair")]] flair : public contract {
          bool isHttp = data.rfind("http:", 0) >= 0 || data.rfind("https:", 0) >= 0;
          check(isHttp, "Link must start with http or https");
          check(data.length() <= 2000, "Link is too long, must be 2000 characters or less");
+      }
+
+      void checkAndSanitizeLink(std::string& data) {
+         if (data.length() == 0) { 
+            return; 
+         }
+
+         checkLink(data);
          htmlspecialchars(data);
       }
 
-      void checkAndSanitizeBio(std::string& data) {
+      void checkBio(const std::string& data) {
          check(data.length() <= 150, "Bio is too long, must be 150 characters or less");
-         htmlspecialchars(data);
       }
 
-      char tolower(char c) {
-         std::map<char, char> lowercaseMap({
-            {'A', 'a'}, {'B', 'b'}, {'C', 'c'}, {'D', 'd'}, {'E', 'e'}, {'F', 'f'},
-            {'G', 'g'}, {'H', 'h'}, {'I', 'i'}, {'J', 'j'}, {'K', 'k'}, {'L', 'l'}, {'M', 'm'}, {'N', 'n'},
-            {'O', 'o'}, {'P', 'p'}, {'Q', 'q'}, {'R', 'r'}, {'S', 's'}, {'T', 't'}, {'U', 'u'}, {'V', 'v'},
-            {'W', 'w'}, {'X', 'x'}, {'Y', 'y'}, {'Z', 'z'},
-         });
+      void checkAndSanitizeBio(std::string& data) {
+         checkBio(data);
+         htmlspecialchars(data);
+      }
 
-         auto it = lowercaseMap.find(c);
-         if(it == lowercaseMap.end()) {
-            return c;
+      /*
+         Validates & stores link and bio. With textmode "hash" only the sha256 and length of the
+         unescaped text are kept, the text itself stays in the action data for indexers.
+      */
+      void setProfileText(profile& row, std::string& link, std::string& bio, bool hashText) {
+         if (hashText) {
+            checkLink(link);
+            checkBio(bio);
+            row.link = "";
+            row.bio = "";
+            row.text.emplace(proftext{
+               sha256(link.data(), link.size()),
+               static_cast<uint32_t>(link.size()),
+               sha256(bio.data(), bio.size()),
+               static_cast<uint32_t>(bio.size())
+            });
+         } else {
+            checkAndSanitizeLink(link);
+            checkAndSanitizeBio(bio);
+            row.link = link;
+            row.bio = bio;
+            // zeroed text, link & bio are in the row
+            row.text.emplace(proftext{});
          }
+      }
 
-         return it->second;
+      static bool isUsernameChar(char c) {
+         return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.';
+      }
+
+      static char tolower(char c) {
+         return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+      }
+
+      // look-alike of a username character, 0 if it has none
+      static char lookAlikeChar(char c) {
+         switch (c) {
+            case 'l': return 'I';
+            case 'I': return 'l';
+            case 'O': return '0';
+            case '0': return 'O';
+            default:  return 0;
+         }
       }
 
       checksum256 hashUsername(std::string username) {
-         std::transform(username.begin(), username.end(), username.begin(),
-            [&](unsigned char c){ return tolower(c); });
+         for (char& c : username) {
+            c = tolower(c);
+         }
          print("lowercase", username, "\n");
          return sha256(&username[0], username.size());
       }
 
-      void checkUsernameExistsSingle(std::string username) {
-         checksum256 usernameHash = hashUsername(username);
+      /*
+         Hash of a username followed by the hashes of its single look-alike substitutions
+      */
+      std::vector<checksum256> hashUsernameVariants(const std::string& username) {
+         std::vector<checksum256> hashes;
+         hashes.push_back(hashUsername(username));
+
+         for (std::string::size_type i = 0; i < username.size(); i++) {
+            char lookAlikeC = lookAlikeChar(username[i]);
+            if (lookAlikeC == 0) {
+               continue;
+            }
+            std::string lookAlike = username;
+            lookAlike[i] = lookAlikeC;
+            hashes.push_back(hashUsername(lookAlike));
+         }
+
+         return hashes;
+      }
+
+      void checkUsernameExists(std::string username) {
          profile_index profiles(_self, _self.value);
          auto byUsernameHashIdx = profiles.get_index<name("byusername")>();
-         auto itr = byUsernameHashIdx.find(usernameHash);
 
-         check(itr->usernameHash != usernameHash, "Username already exists.");
+         for (auto const& usernameHash : hashUsernameVariants(username)) {
+            auto itr = byUsernameHashIdx.find(usernameHash);
+            check(itr == byUsernameHashIdx.end(), "Username already exists.");
+         }
       }
 
-      void checkUsernameExists(std::string username) {
-         std::map<char, char> lookAlikeChars({
-            {'l', 'I'},
-            {'I', 'l'},
-            {'O', '0'},
-            {'0', 'O'},
+      /*
+         Profile index backfill - profiles stored before the byaccount index have no row in it. Such rows are
+         invisible to the account checks and can not be modified on chain, erasing & writing the profile again
+         adds the missing index row.
+      */
+      bool hasAccountIndexRow(profile_index& profiles, const profile& row) {
+         auto byAccountIdx = profiles.get_index<name("byaccount")>();
+         for (auto itr = byAccountIdx.find(row.account.value); itr != byAccountIdx.end() && itr->account == row.account; itr++) {
+            if (itr->id == row.id) { return true; }
+         }
+         return false;
+      }
+
+      profile_index::const_iterator rewriteProfile(profile_index& profiles, profile_index::const_iterator itr) {
+         profile copy = *itr;
+         profiles.erase(itr);
+         return profiles.emplace(_self, [&](profile& row) {
+            row = copy;
+            upgradeRow(row);
          });
+      }
 
-         checkUsernameExistsSingle(username);
+      void checkAccountFree(name account, name profileId) {
+         profile_index profiles(_self, _self.value);
+         auto byAccountIdx = profiles.get_index<name("byaccount")>();
+         auto itr = byAccountIdx.find(account.value);
+         check(itr == byAccountIdx.end() || itr->id == profileId, "Account already has a profile.");
+      }
 
-         for (std::string::size_type i = 0; i < username.size(); i++) {
-            auto it = lookAlikeChars.find(username[i]);
-            if(it == lookAlikeChars.end()) {
-               continue;
-            }
-            std::string lookAlike = username;
-            lookAlike[i] = it->second;
-            checkUsernameExistsSingle(lookAlike);
+      /*
+         Category scopes - contests, entries & votes of a category live under the category id.
+         Rows stored before the tables were partitioned stay in the contract's own scope, which
+         is walked like one more category.
+      */
+      std::vector<uint64_t> contestScopes() {
+         std::vector<uint64_t> scopes{_self.value};
+         category_index categories(_self, _self.value);
+         for (auto const& cat : categories) {
+            scopes.push_back(cat.id.value);
+         }
+         return scopes;
+      }
+
+      uint64_t entryScope(name entryId) {
+         entryscope_index entryscopes(_self, _self.value);
+         auto scopeItr = entryscopes.find(entryId.value);
+         if (scopeItr == entryscopes.end()) {
+            return _self.value;
+         }
+         return scopeItr->categoryId.value;
+      }
+
+      void dropEntryScope(name entryId) {
+         entryscope_index entryscopes(_self, _self.value);
+         auto scopeItr = entryscopes.find(entryId.value);
+         if (scopeItr != entryscopes.end()) {
+            entryscopes.erase(scopeItr);
+         }
+      }
+
+      // contest ids stay unique across scopes, results & events refer to contests by id alone
+      uint64_t nextContestId() {
+         uint64_t contestId = get_option_int(name{"nextcontest"});
+         if (contestId == 0) {
+            contest_index legacyContests(_self, _self.value);
+            result_index contestResults(_self, _self.value);
+            contestId = std::max({legacyContests.available_primary_key(), contestResults.available_primary_key(), uint64_t(1)});
          }
+         set_option(name{"nextcontest"}, contestId + 1);
+         return contestId;
+      }
+
+      // contests of legacy entries still open in the contract's own scope, the limit covers both scopes
+      uint32_t countOpenContestForLevel(const levelrule& level) {
+         uint32_t levelContestCount = countOpenContestInScope(level.id, _self.value);
+         if (level.categoryId.value != _self.value) {
+            levelContestCount += countOpenContestInScope(level.id, level.categoryId.value);
+         }
+         return levelContestCount;
       }
 
-      uint32_t countOpenContestForLevel(name levelId) {
+      uint32_t countOpenContestInScope(name levelId, uint64_t scope) {
          auto now = eosio::current_time_point().sec_since_epoch();
-         contest_index contests(_self, _self.value);
+         contest_index contests(_self, scope);
          auto contestByLevelAndStart = contests.get_index<name("bylevelstart")>();
          auto contestOpenItr = contestByLevelAndStart.upper_bound(composite_key(levelId.value, now));
 
@@ -0,0 +1,309 @@
+"""
+Cost regression suite - preloads a local single node chain with profiles, entries & votes, runs entercontest,
+deposit, vote & update many times and writes the CPU, NET & RAM that nodeos billed for each as a JSON report.
+
+    cd tests
+    python3 cost_suite.py --profiles 1000 --entries 1000 --votes 2000 --runs 200 --out cost_report.json
+    python3 cost_suite.py --profiles 1000 --entries 1000 --votes 2000 --runs 200 --baseline cost_report.json
+
+Profiles are imported 500 per addprofiles. Only --accounts of them get a real account, the rest hold
+placeholder accounts & only add table rows. Entries need a signing account, so the pool enters one free
+level after another, one transaction per entry. The 1M scenarios take hours on a local node.
+"""
+import argparse, json, math, sys, time
+from eosfactory.eosf import *
+
+CONTRACT_WORKSPACE = sys.path[0] + "/../"
+TOKEN_CONTRACT_WORKSPACE = "_iqhgcqllgnpkirjwwkms"
+
+# Actors of the suite:
+MASTER = MasterAccount()
+HOST = Account()
+TOKENHOST = Account()
+
+# name & username digits without look-alike characters (i, l, o)
+ID_ALPHABET = "abcdefghjkmnpqrstuvwxyz"
+
+IMPORT_BATCH = 500
+VOTE_BATCH = 20
+
+def encode_id(prefix, n, width):
+    digits = ""
+    for _ in range(width):
+        digits = ID_ALPHABET[n % len(ID_ALPHABET)] + digits
+        n //= len(ID_ALPHABET)
+    return prefix + digits
+
+def profile_id(n):
+    return encode_id("p", n, 6)
+
+def entry_id(n):
+    return encode_id("e", n, 6)
+
+class BilledCost:
+    def __init__(self):
+        self.cpu = []
+        self.net = []
+        self.ram = []
+
+    def add(self, trace_json):
+        processed = trace_json["processed"]
+        self.cpu.append(processed["receipt"]["cpu_usage_us"])
+        self.net.append(processed["receipt"]["net_usage_words"] * 8)
+        ram = 0
+        for action_trace in processed["action_traces"]:
+            for delta in action_trace.get("account_ram_deltas", []):
+                if delta["account"] == str(HOST):
+                    ram += delta["delta"]
+        self.ram.append(ram)
+
+    @staticmethod
+    def summary(samples):
+        if len(samples) == 0:
+            return {}
+        ordered = sorted(samples)
+        pick = lambda p: ordered[min(len(ordered) - 1, int(p * len(ordered)))]
+        return {
+            "mean": sum(ordered) / len(ordered),
+            "p50": pick(0.5),
+            "p90": pick(0.9),
+            "p99": pick(0.99),
+            "max": ordered[-1],
+        }
+
+    def report(self):
+        return {
+            "runs": len(self.cpu),
+            "cpuUs": self.summary(self.cpu),
+            "netBytes": self.summary(self.net),
+            "ramBytes": self.summary(self.ram),
+        }
+
+def push(contract, action, data, permission):
+    contract.push_action(action, data, force_unique=True, permission=permission)
+    return contract.action.json
+
+def setup_chain(args):
+    reset()
+    create_master_account("MASTER")
+
+    create_account("TOKENHOST", MASTER, account_name='eosio.token')
+    tokSmart = Contract(TOKENHOST, project_from_template(TOKEN_CONTRACT_WORKSPACE, template="eosio_token", remove_existing=True))
+    tokSmart.build()
+    tokSmart.deploy()
+
+    create_account("HOST", MASTER)
+    smart = Contract(HOST, CONTRACT_WORKSPACE)
+    smart.build()
+    smart.deploy()
+
+    HOST.set_account_permission(
+        permission_name=Permission.ACTIVE,
+        add_code=True,
+        permission=(HOST, Permission.OWNER)
+    )
+
+    push(TOKENHOST, "create", {
+        "issuer": MASTER,
+        "maximum_supply": "1000000000.0000 EOS",
+        "can_freeze": "0",
+        "can_recall": "0",
+        "can_whitelist": "0"
+    }, [(MASTER, Permission.ACTIVE), (TOKENHOST, Permission.ACTIVE)])
+
+    admin = (HOST, Permission.ACTIVE)
+    push(HOST, "createcat", {"id": "music", "name": "Music", "maxVideoLength": 30}, admin)
+    push(HOST, "setcurrency", ["EOS"], admin)
+    push(HOST, "setentryexp", [10 * 24 * 3600], admin)
+    push(HOST, "setpricefrsh", [10 * 24 * 3600], admin)
+    push(HOST, "addcurhigh", {"openTime": int(time.time()) - 10, "usdHigh": 50000, "intervalSec": 10 * 24 * 3600}, admin)
+
+def create_level(level_id, price, submission_period, vote_period, args):
+    push(HOST, "createlevel", [{
+        "id": level_id,
+        "name": level_id,
+        "categoryId": "music",
+        "price": price,
+        "participantLimit": args.contest_size,
+        "submissionPeriod": submission_period,
+        "votePeriod": vote_period,
+        "fee": 100,
+        "prizes": [50, 30, 20],
+        "fixedPrize": 0,
+        "allowedSimultaneousContests": 0,
+        "voteStartUTCHour": 0,
+        "minParticipant": 0,
+    }], (HOST, Permission.ACTIVE))
+
+def preload(args, preloaded):
+    accounts = []
+    for i in range(args.accounts):
+        var = "cost_acct_%d" % i
+        create_account(var, MASTER)
+        accounts.append(globals()[var])
+        push(TOKENHOST, "issue", {"to": accounts[-1], "quantity": "1000.0000 EOS", "memo": ""}, (MASTER, Permission.ACTIVE))
+
+    # profiles, the first --accounts of them can sign
+    cost = BilledCost()
+    for start in range(0, args.profiles, IMPORT_BATCH):
+        batch = []
+        for n in range(start, min(args.profiles, start + IMPORT_BATCH)):
+            batch.append({
+                "id": profile_id(n),
+                "username": encode_id("cost", n, 6),
+                "imgHash": "950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account": accounts[n] if n < len(accounts) else encode_id("x", n, 6),
+                "active": True,
+                "link": "",
+                "bio": "",
+            })
+        cost.add(push(HOST, "addprofiles", [batch], (HOST, Permission.ACTIVE)))
+    preloaded["profiles"] = {"rows": args.profiles, "ramBytes": sum(cost.ram)}
+
+    # entries, the account pool enters one free level after another
+    cost = BilledCost()
+    levels = max(1, math.ceil(args.entries / len(accounts)))
+    for level in range(levels):
+        create_level(encode_id("free", level, 4), 0, 60, 7 * 24 * 3600, args)
+    for n in range(args.entries):
+        user = n % len(accounts)
+        cost.add(push(HOST, "entercontest", [{
+            "id": entry_id(n),
+            "userId": profile_id(user),
+            "levelId": encode_id("free", n // len(accounts), 4),
+            "videoHash720p": "%064x" % (n + 1),
+            "videoHash1080p": "%064x" % 0,
+            "coverHash": "%064x" % 0,
+        }], (accounts[user], Permission.ACTIVE)))
+    preloaded["entries"] = {"rows": args.entries, "ramBytes": sum(cost.ram)}
+
+    # voting is open once the last contest is past its submission period
+    time.sleep(61)
+    cost = BilledCost()
+    contests = max(1, args.entries // args.contest_size)
+    votes = 0
+    for first in range(0, contests, VOTE_BATCH):
+        for user in range(len(accounts)):
+            if votes >= args.votes:
+                break
+            # entries c * contestSize + k sit in distinct contests for any fixed k
+            batch = [entry_id(c * args.contest_size + user % args.contest_size) for c in range(first, min(contests, first + VOTE_BATCH))]
+            batch = batch[:args.votes - votes]
+            cost.add(push(HOST, "votebatch", {"voterUserId": profile_id(user), "entryIds": batch}, (accounts[user], Permission.ACTIVE)))
+            votes += len(batch)
+    preloaded["votes"] = {"rows": votes, "ramBytes": sum(cost.ram)}
+
+    for item in preloaded.values():
+        item["ramBytesPerRow"] = item["ramBytes"] / item["rows"] if item["rows"] > 0 else 0
+    return accounts
+
+def measure(args, accounts):
+    costs = {name: BilledCost() for name in ("entercontest", "deposit", "vote", "update")}
+    runs = min(args.runs, len(accounts))
+
+    # entercontest & deposit on a priced level, deposits activate the entries
+    create_level("paid", 1000, 60, 7 * 24 * 3600, args)
+    for user in range(runs):
+        costs["entercontest"].add(push(HOST, "entercontest", [{
+            "id": entry_id(args.entries + user),
+            "userId": profile_id(user),
+            "levelId": "paid",
+            "videoHash720p": "%064x" % (args.entries + user + 1),
+            "videoHash1080p": "%064x" % 0,
+            "coverHash": "%064x" % 0,
+        }], (accounts[user], Permission.ACTIVE)))
+    for user in range(runs):
+        costs["deposit"].add(push(TOKENHOST, "transfer", {
+            "from": accounts[user],
+            "to": HOST,
+            "quantity": "2.0000 EOS",
+            "memo": entry_id(args.entries + user),
+        }, (accounts[user], Permission.ACTIVE)))
+
+    # single votes into the paid contests, once their submission period is over
+    time.sleep(61)
+    paid_contests = max(1, runs // args.contest_size)
+    for user in range(runs):
+        contest = user % paid_contests
+        target = args.entries + contest * args.contest_size + (user * 7) % args.contest_size
+        if target >= args.entries + runs:
+            continue
+        costs["vote"].add(push(HOST, "vote", {"voterUserId": profile_id(user), "entryId": entry_id(target)}, (accounts[user], Permission.ACTIVE)))
+
+    # update settles & archives contests on a short level, each call is one budgeted pass
+    create_level("quick", 0, 1, 5, args)
+    for user in range(runs):
+        push(HOST, "entercontest", [{
+            "id": entry_id(args.entries + runs + user),
+            "userId": profile_id(user),
+            "levelId": "quick",
+            "videoHash720p": "%064x" % (args.entries + runs + user + 1),
+            "videoHash1080p": "%064x" % 0,
+            "coverHash": "%064x" % 0,
+        }], (accounts[user], Permission.ACTIVE))
+    time.sleep(10)
+    for _ in range(args.update_runs):
+        costs["update"].add(push(HOST, "update", {}, (HOST, Permission.ACTIVE)))
+
+    return {name: cost.report() for name, cost in costs.items()}
+
+def compare(report, baseline):
+    print("%-14s %-9s %10s %10s %8s" % ("action", "metric", "baseline", "now", "change"))
+    for action, stats in report["actions"].items():
+        if action not in baseline.get("actions", {}):
+            continue
+        for metric in ("cpuUs", "netBytes", "ramBytes"):
+            for pct in ("p50", "p90"):
+                old = baseline["actions"][action].get(metric, {}).get(pct)
+                new = stats.get(metric, {}).get(pct)
+                if old is None or new is None:
+                    continue
+                change = "%+.1f%%" % ((new - old) * 100.0 / old) if old else "-"
+                print("%-14s %-9s %10s %10s %8s" % (action, metric + " " + pct, old, new, change))
+
+def main():
+    parser = argparse.ArgumentParser(description="Billed CPU, NET & RAM per action on a local chain")
+    parser.add_argument("--profiles", type=int, default=1000)
+    parser.add_argument("--entries", type=int, default=1000)
+    parser.add_argument("--votes", type=int, default=2000)
+    parser.add_argument("--accounts", type=int, default=200, help="profiles with a real, signing account")
+    parser.add_argument("--contest-size", type=int, default=10, help="participant limit of every level")
+    parser.add_argument("--runs", type=int, default=200, help="measured entercontest, deposit & vote calls")
+    parser.add_argument("--update-runs", type=int, default=20)
+    parser.add_argument("--out", default="cost_report.json")
+    parser.add_argument("--baseline", help="earlier report to compare against")
+    args = parser.parse_args()
+    args.accounts = min(args.accounts, args.profiles)
+
+    # set here, the unittest discovery of tests/ imports this module too
+    verbosity([Verbosity.ERROR])
+
+    setup_chain(args)
+    preloaded = {}
+    accounts = preload(args, preloaded)
+    actions = measure(args, accounts)
+    stop()
+
+    report = {
+        "scenario": {
+            "profiles": args.profiles,
+            "entries": args.entries,
+            "votes": args.votes,
+            "accounts": args.accounts,
+            "contestSize": args.contest_size,
+            "runs": args.runs,
+        },
+        "preload": preloaded,
+        "actions": actions,
+    }
+    with open(args.out, "w") as f:
+        json.dump(report, f, indent=4, sort_keys=True)
+        f.write("\n")
+    print("report written to " + args.out)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            compare(report, json.load(f))
+
+if __name__ == "__main__":
+    main()
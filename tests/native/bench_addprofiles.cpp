@@ -0,0 +1,100 @@
+/*
+   Native benchmark - 1k profile import through addprofile one by one versus a single addprofiles batch.
+   Build & run with: make bench
+*/
+#include "flair.cpp"
+
+#include <chrono>
+#include <iostream>
+
+static const uint32_t batchSize = 1000;
+
+static name contractAccount = name("flair");
+
+static std::string makeUsername(uint32_t n) {
+   // fixed width & no i/l/o in the suffix so names never look alike, the "l" in the prefix still
+   // gives every name a variant hash to check
+   static const char* alphabet = "abcdefghjkmnpqrs";
+   std::string username = "flr";
+   for (int i = 0; i < 4; i++) {
+      username += alphabet[n % 16];
+      n /= 16;
+   }
+   return username;
+}
+
+static flair::addprofargs makeProfile(uint32_t n) {
+   flair::addprofargs params;
+   params.id = name(uint64_t(1) << 40 | n);
+   params.username = makeUsername(n);
+   params.account = name(uint64_t(2) << 40 | n);
+   params.link = "https://flair.app/u/" + params.username;
+   params.bio = "Imported profile " + std::to_string(n);
+   params.active = true;
+   return params;
+}
+
+static void resetHost() {
+   native::host().tables.clear();
+   native::host().inlineActions.clear();
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+}
+
+template<typename F>
+static double timeMs(const char* label, F&& fn) {
+   native::host().stats = native::db_stats{};
+   auto start = std::chrono::steady_clock::now();
+   fn();
+   double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+   auto const& stats = native::host().stats;
+   std::cout << label << ": " << ms << " ms (" << ms * 1000 / batchSize << " us/profile), db lookups "
+             << stats.lookups << ", steps " << stats.steps << ", writes " << stats.writes << std::endl;
+   return ms;
+}
+
+int main() {
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   std::vector<flair::addprofargs> firstBatch;
+   std::vector<flair::addprofargs> secondBatch;
+   for (uint32_t i = 0; i < batchSize; i++) {
+      firstBatch.push_back(makeProfile(i));
+      secondBatch.push_back(makeProfile(batchSize + i));
+   }
+
+   resetHost();
+   double single = timeMs("addprofile x1000  (empty table)", [&]() {
+      for (auto const& params : firstBatch) {
+         contract.addprofile(params);
+      }
+   });
+
+   resetHost();
+   double batch = timeMs("addprofiles 1000  (empty table)", [&]() {
+      contract.addprofiles(firstBatch);
+   });
+
+   timeMs("addprofiles 1000  (1k existing)", [&]() {
+      contract.addprofiles(secondBatch);
+   });
+
+   size_t rows = native::host().row_count(contractAccount, contractAccount, name("profiles"));
+   check(rows == 2 * batchSize, "expected every profile to be imported");
+
+   // a look-alike of an imported username must fail the whole batch & leave the table untouched
+   auto clash = makeProfile(3 * batchSize);
+   clash.username = makeUsername(0);
+   clash.username[1] = 'I';
+   try {
+      native::host().apply([&]() { contract.addprofiles({makeProfile(3 * batchSize + 1), clash}); });
+      check(false, "look-alike username was accepted");
+   } catch (const check_failure& e) {
+      check(std::string(e.what()).find("Username already exists") == 0, e.what());
+   }
+   check(native::host().row_count(contractAccount, contractAccount, name("profiles")) == rows, "failed batch was not rolled back");
+
+   std::cout << "speedup: " << single / batch << "x" << std::endl;
+   return 0;
+}
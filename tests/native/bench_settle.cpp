@@ -0,0 +1,94 @@
+/*
+   Native benchmark - settles 200 ten entry contests with ties through update, the winner ranking & option
+   reads it leans on run once per contest.
+   Build & run with: make bench
+*/
+#include "flair.cpp"
+
+#include <chrono>
+#include <iostream>
+
+static const uint32_t contestCount = 200;
+static const uint32_t contestSize = 10;
+
+static name contractAccount = name("flair");
+
+static name profileId(uint32_t n) {
+   return name(uint64_t(1) << 40 | n);
+}
+
+static name entryId(uint32_t n) {
+   return name(uint64_t(3) << 40 | n);
+}
+
+int main() {
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   contract.createcat(name("music"), "Music", 30);
+   contract.setcurrency("EOS");
+   contract.setentryexp(3600);
+   contract.setpricefrsh(3600);
+   contract.addcurhigh(native::host().now - 10, 50000, 3600);
+   contract.deposit(name("funder"), contractAccount, asset(1000000000, symbol("EOS", 4)), "prizefund");
+
+   flair::createlvlargs level{};
+   level.id = name("gold");
+   level.categoryId = name("music");
+   level.name = "Gold";
+   level.participantLimit = contestSize;
+   level.submissionPeriod = 100;
+   level.votePeriod = 100;
+   level.prizes = {500, 300, 200};
+   level.fixedPrize = 1000;
+   contract.createlevel(level);
+
+   uint32_t entryCount = contestCount * contestSize;
+   std::vector<flair::addprofargs> profiles;
+   for (uint32_t i = 0; i < entryCount; i++) {
+      flair::addprofargs params;
+      params.id = profileId(i);
+      params.username = "flr" + std::to_string(100000 + i);
+      params.account = params.id;
+      params.active = true;
+      profiles.push_back(params);
+   }
+   contract.addprofiles(profiles);
+
+   for (uint32_t i = 0; i < entryCount; i++) {
+      native::host().authorize({profileId(i)});
+      flair::contestargs params{};
+      params.id = entryId(i);
+      params.userId = profileId(i);
+      params.levelId = level.id;
+      contract.entercontest(params);
+   }
+
+   // every contest gets a three way tie on top & a two way tie below it
+   native::host().advance(level.submissionPeriod + 1);
+   for (uint32_t i = 0; i < entryCount; i++) {
+      native::host().authorize({profileId(i)});
+      uint32_t first = i - i % contestSize;
+      uint32_t pick = i % contestSize;
+      contract.vote(profileId(i), entryId(first + (pick < 6 ? pick % 3 : 3 + pick % 2)));
+   }
+
+   native::host().advance(level.votePeriod + 1);
+   native::host().authorize({contractAccount});
+   native::host().inlineActions.clear();
+   native::host().stats = native::db_stats{};
+
+   auto start = std::chrono::steady_clock::now();
+   contract.update();
+   double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+   auto const& stats = native::host().stats;
+   std::cout << "update, settle " << contestCount << " contests: " << ms << " ms (" << ms * 1000 / contestCount
+             << " us/contest), db lookups " << stats.lookups << ", steps " << stats.steps << ", writes " << stats.writes
+             << std::endl;
+
+   size_t results = native::host().row_count(contractAccount, contractAccount, name("results"));
+   check(results == contestCount, "expected every contest to be settled");
+   return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <eosio/host.hpp>
+#include <eosio/name.hpp>
+#include <vector>
+
+namespace eosio {
+
+   struct permission_level {
+      permission_level(name a, name p) : actor(a), permission(p) {}
+      permission_level() {}
+
+      name actor;
+      name permission;
+   };
+
+   /*
+      Inline actions are recorded on the host instead of being dispatched
+   */
+   struct action {
+      name account;
+      name name_;
+      std::vector<permission_level> authorization;
+      std::any data;
+
+      template<typename T>
+      action(const permission_level& auth, struct name a, struct name n, T&& value)
+         : account(a), name_(n), authorization{auth}, data(std::forward<T>(value)) {}
+
+      template<typename T>
+      action(std::vector<permission_level> auths, struct name a, struct name n, T&& value)
+         : account(a), name_(n), authorization(std::move(auths)), data(std::forward<T>(value)) {}
+
+      void send() const {
+         std::vector<struct name> actors;
+         for (auto const& level : authorization) {
+            actors.push_back(level.actor);
+         }
+         native::host().inlineActions.push_back(native::inline_action{account, name_, actors, data});
+      }
+   };
+
+}
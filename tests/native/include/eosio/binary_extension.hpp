@@ -0,0 +1,45 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <optional>
+#include <utility>
+
+namespace eosio {
+
+   template<typename T>
+   class binary_extension {
+   public:
+      constexpr binary_extension() {}
+      constexpr binary_extension(const T& ext) : _value(ext) {}
+      constexpr binary_extension(T&& ext) : _value(std::move(ext)) {}
+
+      constexpr bool has_value() const { return _value.has_value(); }
+      constexpr explicit operator bool() const { return has_value(); }
+
+      constexpr T& value() {
+         check(has_value(), "cannot get value of empty binary_extension");
+         return *_value;
+      }
+      constexpr const T& value() const {
+         check(has_value(), "cannot get value of empty binary_extension");
+         return *_value;
+      }
+
+      constexpr T value_or() const { return has_value() ? *_value : T(); }
+      constexpr T value_or(const T& def) const { return has_value() ? *_value : def; }
+
+      constexpr T* operator->() { return &value(); }
+      constexpr const T* operator->() const { return &value(); }
+      constexpr T& operator*() { return value(); }
+      constexpr const T& operator*() const { return value(); }
+
+      template<typename... Args>
+      T& emplace(Args&&... args) { return _value.emplace(std::forward<Args>(args)...); }
+
+      void reset() { _value.reset(); }
+
+   private:
+      std::optional<T> _value;
+   };
+
+}
@@ -0,0 +1,36 @@
+/*
+   Host build of the eosio API used by flair - check() throws instead of aborting the transaction
+*/
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+typedef __int128 int128_t;
+typedef unsigned __int128 uint128_t;
+
+namespace eosio {
+
+   struct check_failure : std::runtime_error {
+      using std::runtime_error::runtime_error;
+   };
+
+   inline void check(bool pred, const char* msg) {
+      if (!pred) { throw check_failure(msg); }
+   }
+
+   inline void check(bool pred, const std::string& msg) {
+      if (!pred) { throw check_failure(msg); }
+   }
+
+   inline void check(bool pred, std::string_view msg) {
+      if (!pred) { throw check_failure(std::string(msg)); }
+   }
+
+   inline void check(bool pred, uint64_t code) {
+      if (!pred) { throw check_failure("assertion failure with error code: " + std::to_string(code)); }
+   }
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <cstring>
+
+namespace eosio {
+
+   template<typename T>
+   class datastream {
+   public:
+      datastream(T start, size_t s) : _start(start), _pos(start), _end(start + s) {}
+
+      inline bool read(char* d, size_t s) {
+         check(size_t(_end - _pos) >= s, "datastream attempted to read past the end");
+         std::memcpy(d, _pos, s);
+         _pos += s;
+         return true;
+      }
+
+      inline bool write(const char* d, size_t s) {
+         check(_end - _pos >= (int32_t)s, "datastream attempted to write past the end");
+         std::memcpy((void*)_pos, d, s);
+         _pos += s;
+         return true;
+      }
+
+      inline void skip(size_t s) { _pos += s; }
+      inline T pos() const { return _pos; }
+      inline size_t tellp() const { return size_t(_pos - _start); }
+      inline size_t remaining() const { return _end - _pos; }
+
+   private:
+      T _start;
+      T _pos;
+      T _end;
+   };
+
+   /*
+      Size-only stream - counts bytes instead of writing them
+   */
+   template<>
+   class datastream<size_t> {
+   public:
+      datastream(size_t init_size = 0) : _size(init_size) {}
+
+      inline bool skip(size_t s) { _size += s; return true; }
+      inline bool write(const char*, size_t s) { _size += s; return true; }
+      inline bool put(char) { ++_size; return true; }
+      inline size_t tellp() const { return _size; }
+      inline size_t remaining() const { return 0; }
+
+   private:
+      size_t _size;
+   };
+
+}
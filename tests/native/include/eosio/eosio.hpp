@@ -0,0 +1,25 @@
+/*
+   Native stand-in for the CDT umbrella header - lets flair.cpp build and run on the host.
+   Only the API surface the contract uses is provided.
+*/
+#pragma once
+
+#include <eosio/action.hpp>
+#include <eosio/check.hpp>
+#include <eosio/contract.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/fixed_bytes.hpp>
+#include <eosio/host.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+#include <eosio/print.hpp>
+#include <eosio/serialize.hpp>
+#include <eosio/system.hpp>
+#include <eosio/varint.hpp>
+
+// the CDT headers pull these in transitively & the contract relies on it
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
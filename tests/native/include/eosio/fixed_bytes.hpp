@@ -0,0 +1,75 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace eosio {
+
+   /*
+      Same word layout as the CDT: bytes are packed big-endian into 128 bit words and
+      comparisons are done word by word, so secondary index order matches the chain.
+   */
+   template<size_t Size>
+   class fixed_bytes {
+   public:
+      typedef uint128_t word_t;
+      static constexpr size_t num_words() { return (Size + sizeof(word_t) - 1) / sizeof(word_t); }
+
+      fixed_bytes() : _data() {}
+      fixed_bytes(const std::array<word_t, num_words()>& arr) : _data(arr) {}
+      fixed_bytes(const std::array<uint8_t, Size>& arr) : _data() {
+         for (size_t i = 0; i < Size; i++) {
+            size_t word = i / sizeof(word_t);
+            _data[word] = (_data[word] << 8) | arr[i];
+         }
+      }
+
+      template<typename Word, typename... Rest>
+      static fixed_bytes<Size> make_from_word_sequence(Word first_word, Rest... rest) {
+         static_assert(sizeof(Word) <= sizeof(word_t), "word is too large");
+         static_assert(sizeof(Word) * (1 + sizeof...(Rest)) <= Size, "too many words supplied");
+
+         std::array<uint8_t, Size> bytes{};
+         std::array<Word, 1 + sizeof...(Rest)> words{{first_word, rest...}};
+         size_t pos = 0;
+         for (auto word : words) {
+            for (size_t b = 0; b < sizeof(Word); b++) {
+               bytes[pos++] = (uint8_t)(word >> (8 * (sizeof(Word) - 1 - b)));
+            }
+         }
+         return fixed_bytes<Size>(bytes);
+      }
+
+      const word_t* data() const { return _data.data(); }
+      word_t* data() { return _data.data(); }
+      constexpr size_t size() const { return _data.size(); }
+      std::array<word_t, num_words()> get_array() const { return _data; }
+
+      std::array<uint8_t, Size> extract_as_byte_array() const {
+         std::array<uint8_t, Size> arr{};
+         for (size_t i = 0; i < Size; i++) {
+            size_t word = i / sizeof(word_t);
+            size_t shift = 8 * (sizeof(word_t) - 1 - (i % sizeof(word_t)));
+            arr[i] = (uint8_t)(_data[word] >> shift);
+         }
+         return arr;
+      }
+
+      friend bool operator==(const fixed_bytes& a, const fixed_bytes& b) { return a._data == b._data; }
+      friend bool operator!=(const fixed_bytes& a, const fixed_bytes& b) { return a._data != b._data; }
+      friend bool operator<(const fixed_bytes& a, const fixed_bytes& b) { return a._data < b._data; }
+      friend bool operator>(const fixed_bytes& a, const fixed_bytes& b) { return b._data < a._data; }
+      friend bool operator<=(const fixed_bytes& a, const fixed_bytes& b) { return !(b._data < a._data); }
+      friend bool operator>=(const fixed_bytes& a, const fixed_bytes& b) { return !(a._data < b._data); }
+
+   private:
+      std::array<word_t, num_words()> _data;
+   };
+
+   typedef fixed_bytes<20> checksum160;
+   typedef fixed_bytes<32> checksum256;
+   typedef fixed_bytes<64> checksum512;
+
+}
@@ -0,0 +1,112 @@
+/*
+   Host side of the native build - simulated clock, authorizations, inline actions and table storage.
+   Benchmarks and tools drive a contract through native::host() the way a node would drive the wasm.
+*/
+#pragma once
+
+#include <eosio/name.hpp>
+#include <any>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace native {
+
+   struct inline_action {
+      eosio::name account;
+      eosio::name action;
+      std::vector<eosio::name> authorization;
+      std::any data;
+   };
+
+   /*
+      Primary rows sit under the table name with keyType 0. Secondary index rows sit under the table name with
+      the index number in its low 4 bits & the key type, like the chain's db_idx* tables, so two layouts of a
+      table only share the indexes they agree on
+   */
+   struct table_key {
+      uint64_t code;
+      uint64_t scope;
+      uint64_t table;
+      uint64_t keyType = 0;
+
+      friend bool operator<(const table_key& a, const table_key& b) {
+         return std::tie(a.code, a.scope, a.table, a.keyType) < std::tie(b.code, b.scope, b.table, b.keyType);
+      }
+   };
+
+   /*
+      Type-erased storage for one primary or secondary table; the typed rows live in multi_index.hpp
+   */
+   struct table_base {
+      virtual ~table_base() {}
+      virtual std::unique_ptr<table_base> clone() const = 0;
+      virtual size_t row_count() const = 0;
+   };
+
+   /*
+      Database intrinsic calls as the chain would bill them - lookups (find / bounds), steps (next / previous)
+      and writes (store / update / remove), primary & secondary combined
+   */
+   struct db_stats {
+      uint64_t lookups = 0;
+      uint64_t steps = 0;
+      uint64_t writes = 0;
+   };
+
+   struct host_state {
+      eosio::name receiver;
+      uint32_t now = 1577836800;
+      bool printing = false;
+      std::function<void(const char*)> printSink;   // e.g. tools marking phases by the contract's prints
+      std::vector<eosio::name> auths;
+      std::vector<inline_action> inlineActions;
+      std::vector<eosio::name> notified;
+      db_stats stats;
+      std::map<table_key, std::unique_ptr<table_base>> tables;
+
+      void set_time(uint32_t sec) { now = sec; }
+      void advance(uint32_t sec) { now += sec; }
+      void authorize(std::vector<eosio::name> accounts) { auths = std::move(accounts); }
+
+      size_t row_count(eosio::name code, eosio::name scope, eosio::name table) const {
+         auto itr = tables.find(table_key{code.value, scope.value, table.value});
+         return itr == tables.end() ? 0 : itr->second->row_count();
+      }
+
+      /*
+         Runs one action as a transaction - table writes and inline actions are rolled back
+         when a check fails, and the failure is rethrown to the caller
+      */
+      template<typename F>
+      void apply(F&& fn) {
+         std::map<table_key, std::unique_ptr<table_base>> snapshot;
+         for (auto const& table : tables) {
+            snapshot.emplace(table.first, table.second->clone());
+         }
+         size_t inlineCount = inlineActions.size();
+         size_t notifiedCount = notified.size();
+         try {
+            fn();
+         } catch (...) {
+            tables = std::move(snapshot);
+            inlineActions.resize(inlineCount);
+            notified.resize(notifiedCount);
+            throw;
+         }
+      }
+   };
+
+   inline host_state& host() {
+      static host_state state;
+      return state;
+   }
+
+   inline eosio::name current_receiver() {
+      return host().receiver;
+   }
+
+}
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/fixed_bytes.hpp>
+#include <eosio/host.hpp>
+#include <eosio/name.hpp>
+#include <iterator>
+#include <map>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <type_traits>
+
+namespace eosio {
+
+   template<name::raw IndexName, typename Extractor>
+   struct indexed_by {
+      static constexpr name::raw index_name = IndexName;
+      typedef Extractor secondary_extractor_type;
+   };
+
+   template<class Class, typename Type, Type (Class::*PtrToMemberFunction)() const>
+   struct const_mem_fun {
+      typedef typename std::remove_cv_t<std::remove_reference_t<Type>> result_type;
+
+      result_type operator()(const Class& x) const { return (x.*PtrToMemberFunction)(); }
+   };
+
+   namespace detail {
+
+      // rows keyed by primary key
+      template<typename T>
+      struct table_store : native::table_base {
+         std::map<uint64_t, T> rows;
+
+         std::unique_ptr<native::table_base> clone() const override {
+            return std::make_unique<table_store>(*this);
+         }
+
+         size_t row_count() const override { return rows.size(); }
+      };
+
+      // one (secondary key, primary key) set per index - the same ordering the chain keeps for db_idx* tables
+      template<typename Key>
+      struct secondary_store : native::table_base {
+         std::set<std::pair<Key, uint64_t>> keys;
+
+         std::unique_ptr<native::table_base> clone() const override {
+            return std::make_unique<secondary_store>(*this);
+         }
+
+         size_t row_count() const override { return keys.size(); }
+      };
+
+      // the db_idx* table family of a key type
+      template<typename Key>
+      constexpr uint64_t secondary_key_type() {
+         if constexpr (std::is_same_v<Key, uint64_t>) {
+            return 1;
+         } else if constexpr (std::is_same_v<Key, uint128_t>) {
+            return 2;
+         } else if constexpr (std::is_same_v<Key, checksum256>) {
+            return 3;
+         } else if constexpr (std::is_same_v<Key, double>) {
+            return 4;
+         } else {
+            static_assert(std::is_same_v<Key, long double>, "no secondary index for this key type");
+            return 5;
+         }
+      }
+
+      template<typename store_type>
+      store_type* find_store(const native::table_key& key) {
+         auto& slot = native::host().tables[key];
+         if (!slot) {
+            slot = std::make_unique<store_type>();
+         }
+         return static_cast<store_type*>(slot.get());
+      }
+
+   }
+
+   template<name::raw TableName, typename T, typename... Indices>
+   class multi_index {
+   private:
+      typedef detail::table_store<T> store_type;
+      typedef std::index_sequence_for<Indices...> index_sequence;
+      typedef std::tuple<detail::secondary_store<typename Indices::secondary_extractor_type::result_type>*...> secondaries_type;
+
+      name _code;
+      uint64_t _scope;
+      store_type* _store;
+      secondaries_type _secondaries;
+
+      template<size_t I>
+      using extractor_at = typename std::tuple_element_t<I, std::tuple<Indices...>>::secondary_extractor_type;
+
+      template<size_t... I>
+      void open_secondaries(std::index_sequence<I...>) {
+         ((std::get<I>(_secondaries) = detail::find_store<std::remove_pointer_t<std::tuple_element_t<I, secondaries_type>>>(
+            native::table_key{_code.value, _scope, (static_cast<uint64_t>(TableName) & 0xFFFFFFFFFFFFFFF0ULL) | I,
+                              detail::secondary_key_type<typename extractor_at<I>::result_type>()})), ...);
+      }
+
+      template<size_t... I>
+      void insert_keys(const T& row, std::index_sequence<I...>) {
+         (std::get<I>(_secondaries)->keys.emplace(extractor_at<I>{}(row), row.primary_key()), ...);
+      }
+
+      // rows written under another layout of the table may have no entry in an index, erasing skips those
+      template<size_t... I>
+      void erase_keys(const T& row, std::index_sequence<I...>) {
+         (std::get<I>(_secondaries)->keys.erase(std::make_pair(extractor_at<I>{}(row), row.primary_key())), ...);
+      }
+
+      // like db_idx*_update only changed keys are rewritten, & those must exist in the index
+      template<size_t... I>
+      void update_keys(const T& before, const T& row, std::index_sequence<I...>) {
+         ([&] {
+            auto oldKey = extractor_at<I>{}(before);
+            auto newKey = extractor_at<I>{}(row);
+            if (oldKey == newKey) { return; }
+            auto& keys = std::get<I>(_secondaries)->keys;
+            check(keys.erase(std::make_pair(oldKey, row.primary_key())) == 1, "secondary index row not found for modify");
+            keys.emplace(newKey, row.primary_key());
+         }(), ...);
+      }
+
+      static const T& empty_row() {
+         static const T row{};
+         return row;
+      }
+
+   public:
+      /*
+         Primary iterator - dereferencing end() yields a zeroed row, as reading an
+         invalid iterator does in wasm memory
+      */
+      class const_iterator {
+      public:
+         typedef std::bidirectional_iterator_tag iterator_category;
+         typedef const T value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const T* pointer;
+         typedef const T& reference;
+
+         const_iterator() {}
+         const_iterator(store_type* s, typename std::map<uint64_t, T>::iterator i) : store(s), itr(i) {}
+
+         const T& operator*() const { return itr == store->rows.end() ? empty_row() : itr->second; }
+         const T* operator->() const { return &**this; }
+
+         const_iterator& operator++() {
+            check(itr != store->rows.end(), "cannot increment end iterator");
+            native::host().stats.steps++;
+            ++itr;
+            return *this;
+         }
+         const_iterator operator++(int) { const_iterator result = *this; ++*this; return result; }
+
+         const_iterator& operator--() {
+            check(itr != store->rows.begin(), "cannot decrement iterator at beginning of table");
+            native::host().stats.steps++;
+            --itr;
+            return *this;
+         }
+         const_iterator operator--(int) { const_iterator result = *this; --*this; return result; }
+
+         friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.itr == b.itr; }
+         friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.itr != b.itr; }
+
+         store_type* store = nullptr;
+         typename std::map<uint64_t, T>::iterator itr;
+      };
+
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+      /*
+         Secondary iterator - tracks the row, not its slot in the key set, so it keeps
+         pointing at the row after modify() re-sorts it
+      */
+      template<size_t I>
+      class index {
+      public:
+         typedef typename std::tuple_element_t<I, std::tuple<Indices...>>::secondary_extractor_type extractor_type;
+         typedef typename extractor_type::result_type secondary_key_type;
+         typedef std::set<std::pair<secondary_key_type, uint64_t>> key_set;
+
+         class const_iterator {
+         public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef const T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T* pointer;
+            typedef const T& reference;
+
+            const_iterator() {}
+            const_iterator(const index* i, bool e, uint64_t p) : idx(i), atEnd(e), pk(p) {}
+
+            const T& operator*() const {
+               if (atEnd) {
+                  return empty_row();
+               }
+               return idx->_multi->_store->rows.at(pk);
+            }
+            const T* operator->() const { return &**this; }
+
+            const_iterator& operator++() {
+               check(!atEnd, "cannot increment end iterator");
+               native::host().stats.steps++;
+               auto& keys = idx->keys();
+               auto next = keys.upper_bound(std::make_pair(extractor_type{}(**this), pk));
+               set(next);
+               return *this;
+            }
+            const_iterator operator++(int) { const_iterator result = *this; ++*this; return result; }
+
+            const_iterator& operator--() {
+               auto& keys = idx->keys();
+               auto cur = atEnd ? keys.end() : keys.lower_bound(std::make_pair(extractor_type{}(**this), pk));
+               check(cur != keys.begin(), "cannot decrement iterator at beginning of index");
+               native::host().stats.steps++;
+               set(--cur);
+               return *this;
+            }
+            const_iterator operator--(int) { const_iterator result = *this; --*this; return result; }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) {
+               return a.atEnd == b.atEnd && (a.atEnd || a.pk == b.pk);
+            }
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+
+            void set(typename key_set::const_iterator i) {
+               atEnd = i == idx->keys().end();
+               pk = atEnd ? 0 : i->second;
+            }
+
+            const index* idx = nullptr;
+            bool atEnd = true;
+            uint64_t pk = 0;
+         };
+
+         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+         index(multi_index* m) : _multi(m) {}
+
+         const key_set& keys() const { return std::get<I>(_multi->_secondaries)->keys; }
+
+         name get_code() const { return _multi->get_code(); }
+         uint64_t get_code_scope() const { return _multi->get_scope(); }
+
+         const_iterator make(typename key_set::const_iterator i) const {
+            const_iterator result(this, true, 0);
+            result.set(i);
+            return result;
+         }
+
+         const_iterator begin() const {
+            native::host().stats.lookups++;
+            return make(keys().begin());
+         }
+         const_iterator cbegin() const { return begin(); }
+         const_iterator end() const { return const_iterator(this, true, 0); }
+         const_iterator cend() const { return end(); }
+         const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+         const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+         const_iterator lower_bound(const secondary_key_type& key) const {
+            native::host().stats.lookups++;
+            return make(keys().lower_bound(std::make_pair(key, uint64_t(0))));
+         }
+
+         const_iterator upper_bound(const secondary_key_type& key) const {
+            native::host().stats.lookups++;
+            return make(keys().upper_bound(std::make_pair(key, std::numeric_limits<uint64_t>::max())));
+         }
+
+         const_iterator find(const secondary_key_type& key) const {
+            auto itr = lower_bound(key);
+            if (itr == end() || extractor_type{}(*itr) != key) {
+               return end();
+            }
+            return itr;
+         }
+
+         const T& get(const secondary_key_type& key, const char* error_msg = "unable to find secondary key") const {
+            auto result = find(key);
+            check(result != end(), error_msg);
+            return *result;
+         }
+
+         const_iterator iterator_to(const T& obj) const {
+            return const_iterator(this, false, obj.primary_key());
+         }
+
+         template<typename Lambda>
+         void modify(const_iterator itr, name payer, Lambda&& updater) {
+            check(!itr.atEnd, "cannot pass end iterator to modify");
+            _multi->modify(_multi->row_iterator(itr.pk), payer, std::forward<Lambda>(updater));
+         }
+
+         const_iterator erase(const_iterator itr) {
+            check(!itr.atEnd, "cannot pass end iterator to erase");
+            const_iterator next = itr;
+            ++next;
+            _multi->erase(_multi->row_iterator(itr.pk));
+            return next;
+         }
+
+         multi_index* _multi;
+      };
+
+      multi_index(name code, uint64_t scope) : _code(code), _scope(scope) {
+         _store = detail::find_store<store_type>(native::table_key{code.value, scope, static_cast<uint64_t>(TableName)});
+         open_secondaries(index_sequence{});
+      }
+
+      name get_code() const { return _code; }
+      uint64_t get_scope() const { return _scope; }
+
+      const_iterator begin() const {
+         native::host().stats.lookups++;
+         return const_iterator(_store, _store->rows.begin());
+      }
+      const_iterator cbegin() const { return begin(); }
+      const_iterator end() const { return const_iterator(_store, _store->rows.end()); }
+      const_iterator cend() const { return end(); }
+      const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+      const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+      const_iterator lower_bound(uint64_t primary) const {
+         native::host().stats.lookups++;
+         return const_iterator(_store, _store->rows.lower_bound(primary));
+      }
+
+      const_iterator upper_bound(uint64_t primary) const {
+         native::host().stats.lookups++;
+         return const_iterator(_store, _store->rows.upper_bound(primary));
+      }
+
+      const_iterator find(uint64_t primary) const {
+         native::host().stats.lookups++;
+         return const_iterator(_store, _store->rows.find(primary));
+      }
+
+      const_iterator require_find(uint64_t primary, const char* error_msg = "unable to find key") const {
+         auto itr = find(primary);
+         check(itr != end(), error_msg);
+         return itr;
+      }
+
+      const T& get(uint64_t primary, const char* error_msg = "unable to find key") const {
+         return *require_find(primary, error_msg);
+      }
+
+      const_iterator iterator_to(const T& obj) const { return row_iterator(obj.primary_key()); }
+
+      // iterator to a row already located, no lookup is billed
+      const_iterator row_iterator(uint64_t primary) const {
+         return const_iterator(_store, _store->rows.find(primary));
+      }
+
+      uint64_t available_primary_key() const {
+         return _store->rows.empty() ? 0 : _store->rows.rbegin()->first + 1;
+      }
+
+      template<name::raw IndexName>
+      auto get_index() {
+         return index<index_position<IndexName>()>(this);
+      }
+
+      template<name::raw IndexName>
+      static constexpr size_t index_position() {
+         constexpr name::raw names[] = {Indices::index_name...};
+         for (size_t i = 0; i < sizeof...(Indices); i++) {
+            if (names[i] == IndexName) {
+               return i;
+            }
+         }
+         return sizeof...(Indices);
+      }
+
+      template<typename Lambda>
+      const_iterator emplace(name payer, Lambda&& constructor) {
+         check(_code == native::current_receiver(), "cannot create objects in table of another contract");
+         T row{};
+         constructor(row);
+         uint64_t pk = row.primary_key();
+         check(_store->rows.find(pk) == _store->rows.end(), "could not insert object, most likely a uniqueness constraint was violated");
+         native::host().stats.writes++;
+         auto inserted = _store->rows.emplace(pk, std::move(row)).first;
+         insert_keys(inserted->second, index_sequence{});
+         return const_iterator(_store, inserted);
+      }
+
+      template<typename Lambda>
+      void modify(const_iterator itr, name payer, Lambda&& updater) {
+         check(itr != end(), "cannot pass end iterator to modify");
+         check(_code == native::current_receiver(), "cannot modify objects in table of another contract");
+         native::host().stats.writes++;
+         T& row = itr.itr->second;
+         T before = row;
+         updater(row);
+         check(before.primary_key() == row.primary_key(), "updater cannot change primary key when modifying an object");
+         update_keys(before, row, index_sequence{});
+      }
+
+      template<typename Lambda>
+      void modify(const T& obj, name payer, Lambda&& updater) {
+         modify(iterator_to(obj), payer, std::forward<Lambda>(updater));
+      }
+
+      const_iterator erase(const_iterator itr) {
+         check(itr != end(), "cannot pass end iterator to erase");
+         check(_code == native::current_receiver(), "cannot erase objects in table of another contract");
+         native::host().stats.writes++;
+         erase_keys(itr.itr->second, index_sequence{});
+         return const_iterator(_store, _store->rows.erase(itr.itr));
+      }
+
+      void erase(const T& obj) { erase(iterator_to(obj)); }
+   };
+
+}
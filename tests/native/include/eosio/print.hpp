@@ -0,0 +1,43 @@
+#pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/host.hpp>
+#include <iostream>
+#include <sstream>
+
+namespace eosio {
+
+   namespace detail {
+      inline void print_one(std::ostream& out, const char* s) { out << s; }
+      inline void print_one(std::ostream& out, const std::string& s) { out << s; }
+      inline void print_one(std::ostream& out, std::string_view s) { out << s; }
+      inline void print_one(std::ostream& out, char c) { out << c; }
+      inline void print_one(std::ostream& out, bool b) { out << (b ? "true" : "false"); }
+      inline void print_one(std::ostream& out, name n) { out << n.to_string(); }
+      inline void print_one(std::ostream& out, const asset& a) { out << a.to_string(); }
+      inline void print_one(std::ostream& out, const symbol& s) { out << (int)s.precision() << "," << s.code().to_string(); }
+      inline void print_one(std::ostream& out, const symbol_code& s) { out << s.to_string(); }
+      inline void print_one(std::ostream& out, uint128_t v) { out << (uint64_t)(v >> 64) << ":" << (uint64_t)v; }
+      inline void print_one(std::ostream& out, int128_t v) { print_one(out, (uint128_t)v); }
+
+      template<typename T>
+      inline auto print_one(std::ostream& out, T v) -> std::enable_if_t<std::is_arithmetic_v<T>> { out << +v; }
+   }
+
+   /*
+      Output is dropped unless the host turns it on - benchmarks would otherwise measure stdout. The host's print
+      sink, when one is set, gets each print formatted as a whole.
+   */
+   template<typename... Args>
+   inline void print(Args&&... args) {
+      if (native::host().printSink) {
+         std::ostringstream out;
+         (detail::print_one(out, args), ...);
+         native::host().printSink(out.str().c_str());
+      }
+      if (native::host().printing) {
+         (detail::print_one(std::cout, std::forward<Args>(args)), ...);
+      }
+   }
+
+}
@@ -0,0 +1,159 @@
+/*
+   Host build of eosio::pack / eosio::pack_size - same wire format as the CDT datastream. Table structs carry no
+   EOSLIB_SERIALIZE, so like the CDT (boost pfr) their fields are found through aggregate initialization &
+   structured bindings.
+*/
+#pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/fixed_bytes.hpp>
+#include <eosio/name.hpp>
+#include <eosio/symbol.hpp>
+#include <eosio/varint.hpp>
+#include <list>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace eosio {
+
+   namespace detail {
+
+      // converts to any field type, counting how many a struct takes
+      struct any_field {
+         template<typename T>
+         constexpr operator T&() const && noexcept;
+      };
+
+      template<typename T, typename Indices, typename = void>
+      struct takes_fields : std::false_type {};
+
+      template<typename T, size_t... I>
+      struct takes_fields<T, std::index_sequence<I...>, std::void_t<decltype(T{(void(I), any_field{})...})>>
+         : std::true_type {};
+
+      template<typename T, size_t N = 24>
+      constexpr size_t field_count() {
+         if constexpr (N == 0) {
+            return 0;
+         } else if constexpr (takes_fields<T, std::make_index_sequence<N>>::value) {
+            return N;
+         } else {
+            return field_count<T, N - 1>();
+         }
+      }
+
+      template<typename T, typename F>
+      void for_each_field(const T& t, F&& f) {
+         constexpr size_t n = field_count<T>();
+         static_assert(n <= 20, "struct has more fields than for_each_field unpacks");
+         if constexpr (n == 1) { auto const& [a] = t; f(a); }
+         else if constexpr (n == 2) { auto const& [a, b] = t; f(a); f(b); }
+         else if constexpr (n == 3) { auto const& [a, b, c] = t; f(a); f(b); f(c); }
+         else if constexpr (n == 4) { auto const& [a, b, c, d] = t; f(a); f(b); f(c); f(d); }
+         else if constexpr (n == 5) { auto const& [a, b, c, d, e] = t; f(a); f(b); f(c); f(d); f(e); }
+         else if constexpr (n == 6) { auto const& [a, b, c, d, e, g] = t; f(a); f(b); f(c); f(d); f(e); f(g); }
+         else if constexpr (n == 7) { auto const& [a, b, c, d, e, g, h] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); }
+         else if constexpr (n == 8) { auto const& [a, b, c, d, e, g, h, i] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); }
+         else if constexpr (n == 9) { auto const& [a, b, c, d, e, g, h, i, j] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); }
+         else if constexpr (n == 10) { auto const& [a, b, c, d, e, g, h, i, j, k] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); }
+         else if constexpr (n == 11) { auto const& [a, b, c, d, e, g, h, i, j, k, l] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); }
+         else if constexpr (n == 12) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); }
+         else if constexpr (n == 13) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); }
+         else if constexpr (n == 14) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); }
+         else if constexpr (n == 15) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); }
+         else if constexpr (n == 16) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); f(r); }
+         else if constexpr (n == 17) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r, s] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); f(r); f(s); }
+         else if constexpr (n == 18) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r, s, u] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); f(r); f(s); f(u); }
+         else if constexpr (n == 19) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r, s, u, v] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); f(r); f(s); f(u); f(v); }
+         else if constexpr (n == 20) { auto const& [a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r, s, u, v, w] = t; f(a); f(b); f(c); f(d); f(e); f(g); f(h); f(i); f(j); f(k); f(l); f(m); f(o); f(p); f(q); f(r); f(s); f(u); f(v); f(w); }
+      }
+
+      template<typename T> struct is_vector : std::false_type {};
+      template<typename T> struct is_vector<std::vector<T>> : std::true_type {};
+      template<typename T> struct is_vector<std::list<T>> : std::true_type {};
+      template<typename T> struct is_extension : std::false_type {};
+      template<typename T> struct is_extension<binary_extension<T>> : std::true_type {};
+      template<typename T> struct is_optional : std::false_type {};
+      template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+      template<typename T> struct is_tuple : std::false_type {};
+      template<typename... T> struct is_tuple<std::tuple<T...>> : std::true_type {};
+      template<typename A, typename B> struct is_tuple<std::pair<A, B>> : std::true_type {};
+      template<typename T> struct is_fixed_bytes : std::false_type {};
+      template<size_t Size> struct is_fixed_bytes<fixed_bytes<Size>> : std::true_type {};
+
+      template<typename Stream>
+      void write_varuint32(Stream& ds, uint32_t v) {
+         do {
+            char b = char(v & 0x7f);
+            v >>= 7;
+            b |= char((v > 0) << 7);
+            ds.write(&b, 1);
+         } while (v > 0);
+      }
+
+      template<typename Stream, typename T>
+      void write_value(Stream& ds, const T& v) {
+         if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, uint128_t> || std::is_same_v<T, int128_t>) {
+            ds.write((const char*)&v, sizeof(v));
+         } else if constexpr (std::is_same_v<T, unsigned_int>) {
+            write_varuint32(ds, v.value);
+         } else if constexpr (std::is_same_v<T, name>) {
+            ds.write((const char*)&v.value, sizeof(v.value));
+         } else if constexpr (std::is_same_v<T, symbol> || std::is_same_v<T, symbol_code>) {
+            uint64_t raw = v.raw();
+            ds.write((const char*)&raw, sizeof(raw));
+         } else if constexpr (std::is_same_v<T, asset>) {
+            write_value(ds, v.amount);
+            write_value(ds, v.symbol);
+         } else if constexpr (is_fixed_bytes<T>::value) {
+            auto bytes = v.extract_as_byte_array();
+            ds.write((const char*)bytes.data(), bytes.size());
+         } else if constexpr (std::is_same_v<T, std::string>) {
+            write_varuint32(ds, v.size());
+            ds.write(v.data(), v.size());
+         } else if constexpr (is_vector<T>::value) {
+            write_varuint32(ds, v.size());
+            for (auto const& item : v) {
+               write_value(ds, item);
+            }
+         } else if constexpr (is_extension<T>::value) {
+            // absent extensions take no bytes, they can only trail a row
+            if (v.has_value()) {
+               write_value(ds, v.value());
+            }
+         } else if constexpr (is_optional<T>::value) {
+            write_value(ds, bool(v));
+            if (v) {
+               write_value(ds, *v);
+            }
+         } else if constexpr (is_tuple<T>::value) {
+            std::apply([&](auto const&... items) { (write_value(ds, items), ...); }, v);
+         } else {
+            static_assert(std::is_aggregate_v<T>, "no packing for this type");
+            for_each_field(v, [&](auto const& field) { write_value(ds, field); });
+         }
+      }
+
+   }
+
+   template<typename T>
+   size_t pack_size(const T& v) {
+      datastream<size_t> ds;
+      detail::write_value(ds, v);
+      return ds.tellp();
+   }
+
+   template<typename T>
+   std::vector<char> pack(const T& v) {
+      std::vector<char> bytes(pack_size(v));
+      datastream<char*> ds(bytes.data(), bytes.size());
+      detail::write_value(ds, v);
+      return bytes;
+   }
+
+}
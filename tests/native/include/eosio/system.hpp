@@ -0,0 +1,31 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/host.hpp>
+#include <eosio/time.hpp>
+#include <algorithm>
+
+namespace eosio {
+
+   inline time_point current_time_point() {
+      return time_point(seconds(native::host().now));
+   }
+
+   inline bool has_auth(name n) {
+      auto const& auths = native::host().auths;
+      return std::find(auths.begin(), auths.end(), n) != auths.end();
+   }
+
+   inline void require_auth(name n) {
+      check(has_auth(n), "missing authority of " + n.to_string());
+   }
+
+   inline void require_recipient(name notify_account) {
+      native::host().notified.push_back(notify_account);
+   }
+
+   inline bool is_account(name n) {
+      return n.value != 0;
+   }
+
+}
@@ -0,0 +1,229 @@
+/*
+   RAM plan - sizes every flair table row with eosio::pack on the same structs the contract stores, adds the
+   secondary index entries each row keeps, and projects contract RAM for a given number of users, entries per
+   contest & votes per entry.
+
+   Billed sizes follow nodeos: a row costs its packed size plus 108 bytes, each secondary index entry 128 bytes
+   (uint64_t, double), 136 (uint128_t, long double) or 152 (checksum256), and every (scope, table) pair plus one
+   per secondary index costs 108 bytes the first time a row lands in it.
+
+   Build & run with: make ramplan && ./ramplan --users 100000 --entries-per-user 5 --entries-per-contest 10
+*/
+#include <eosio/eosio.hpp>
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+// the table structs are private to the contract
+#define private public
+#include "flair.cpp"
+#undef private
+
+static const uint64_t rowOverhead = 108;       // key_value_object
+static const uint64_t tableOverhead = 108;     // table_id_object, per scope & per index
+
+template<typename Key>
+constexpr uint64_t secondaryBytes() {
+   if constexpr (std::is_same_v<Key, uint64_t> || std::is_same_v<Key, double>) {
+      return 128;
+   } else if constexpr (std::is_same_v<Key, uint128_t> || std::is_same_v<Key, long double>) {
+      return 136;
+   } else {
+      static_assert(std::is_same_v<Key, checksum256>, "no billable size for this secondary key");
+      return 152;
+   }
+}
+
+/*
+   Table Layout - row type & secondary index costs of a multi_index typedef
+*/
+template<typename Table>
+struct table_layout;
+
+template<name::raw TableName, typename T, typename... Indices>
+struct table_layout<multi_index<TableName, T, Indices...>> {
+   typedef T row_type;
+   static constexpr name::raw table_name = TableName;
+   static constexpr uint64_t indices = sizeof...(Indices);
+   static constexpr uint64_t index_bytes = (uint64_t(0) + ... + secondaryBytes<typename Indices::secondary_extractor_type::result_type>());
+};
+
+struct table_plan {
+   std::string table;
+   uint64_t packedBytes;
+   uint64_t indices;
+   uint64_t indexBytes;
+   uint64_t rows;
+   uint64_t scopes;
+
+   uint64_t row_bytes() const { return rowOverhead + packedBytes + indexBytes; }
+   uint64_t table_bytes() const { return scopes * tableOverhead * (1 + indices); }
+   uint64_t total_bytes() const { return rows * row_bytes() + table_bytes(); }
+};
+
+template<typename Table>
+table_plan plan(const typename table_layout<Table>::row_type& sample, uint64_t rows, uint64_t scopes) {
+   typedef table_layout<Table> layout;
+   return table_plan{
+      name(layout::table_name).to_string(),
+      eosio::pack_size(sample),
+      layout::indices,
+      layout::index_bytes,
+      rows,
+      rows > 0 ? scopes : 0,
+   };
+}
+
+struct scenario {
+   uint64_t users = 10000;
+   uint64_t entriesPerUser = 5;
+   uint64_t entriesPerContest = 10;
+   uint64_t votesPerEntry = 10;
+   uint64_t categories = 1;
+   uint64_t winners = 3;
+   uint64_t levels = 10;
+   uint64_t usernameLength = 12;
+   uint64_t linkLength = 0;
+   uint64_t bioLength = 0;
+};
+
+static void usage() {
+   std::cerr << "usage: ramplan [--users N] [--entries-per-user N] [--entries-per-contest N] [--votes-per-entry N]\n"
+             << "               [--categories N] [--winners N] [--levels N] [--username-length N] [--link-length N]\n"
+             << "               [--bio-length N]" << std::endl;
+}
+
+static bool parseArgs(int argc, char** argv, scenario& s) {
+   struct flag { const char* name; uint64_t* value; } flags[] = {
+      {"--users", &s.users},
+      {"--entries-per-user", &s.entriesPerUser},
+      {"--entries-per-contest", &s.entriesPerContest},
+      {"--votes-per-entry", &s.votesPerEntry},
+      {"--categories", &s.categories},
+      {"--winners", &s.winners},
+      {"--levels", &s.levels},
+      {"--username-length", &s.usernameLength},
+      {"--link-length", &s.linkLength},
+      {"--bio-length", &s.bioLength},
+   };
+
+   for (int i = 1; i < argc; i++) {
+      bool known = false;
+      for (auto const& f : flags) {
+         if (std::strcmp(argv[i], f.name) == 0 && i + 1 < argc) {
+            *f.value = std::stoull(argv[++i]);
+            known = true;
+            break;
+         }
+      }
+      if (!known) {
+         return false;
+      }
+   }
+   return s.entriesPerContest > 0 && s.categories > 0;
+}
+
+/*
+   Sample Rows - every field set the way the contract writes it, strings at the requested lengths
+*/
+static std::vector<table_plan> project(const scenario& s) {
+   uint64_t entries = s.users * s.entriesPerUser;
+   uint64_t contests = (entries + s.entriesPerContest - 1) / s.entriesPerContest;
+   uint64_t votes = entries * s.votesPerEntry;
+   uint64_t winners = std::min(contests * s.winners, entries);
+   uint64_t categoryScopes = std::min(s.categories, std::max<uint64_t>(contests, 1));
+   asset tokens(10000, symbol("EOS", 4));
+
+   flair::category category{name("music"), "Music", 30, false};
+
+   flair::level level{};
+   level.id = name("gold");
+   level.categoryId = name("music");
+   level.name = "Gold";
+   level.prizes = std::vector<uint32_t>(s.winners, 100);
+   level.schemaVersion.emplace(flair::levelSchemaVersion);
+
+   flair::levelrule levelrule{};
+   levelrule.id = name("gold");
+   levelrule.categoryId = name("music");
+   for (uint32_t rank = 0; rank < s.winners; rank++) {
+      levelrule.prizeSums.push_back(100 * (rank + 1));
+   }
+
+   flair::profile profile{};
+   profile.id = name("profile");
+   profile.username = std::string(s.usernameLength, 'a');
+   profile.link = std::string(s.linkLength, 'a');
+   profile.bio = std::string(s.bioLength, 'a');
+   profile.account = name("account");
+   profile.winnings = tokens;
+   profile.text.emplace(flair::proftext{});
+   profile.schemaVersion.emplace(flair::profileSchemaVersion);
+
+   flair::profauth profauth{name("profile"), name("account"), true, 0};
+   flair::balance balance{name("profile"), tokens, 0};
+   flair::profstat profstat{name("profile"), 0, 0, 0, tokens, 0};
+
+   flair::contestEntry entry{};
+   entry.id = name("entry");
+   entry.prizeGiven = tokens;
+   entry.schemaVersion.emplace(flair::entrySchemaVersion);
+
+   flair::entryscope entryscope{name("entry"), name("music")};
+
+   flair::contest contest{};
+   contest.levelId = name("gold");
+   contest.schemaVersion.emplace(flair::contestSchemaVersion);
+
+   flair::entryvote vote{};
+
+   flair::contestresult result{};
+   result.prizePool = tokens;
+   result.fee = tokens;
+   result.winners = std::vector<flair::resultwinner>(s.winners, flair::resultwinner{name("entry"), name("profile"), 0, tokens});
+
+   return {
+      plan<flair::category_index>(category, s.categories, 1),
+      plan<flair::level_index>(level, s.levels, 1),
+      plan<flair::levelrule_index>(levelrule, s.levels, 1),
+      plan<flair::profile_index>(profile, s.users, 1),
+      plan<flair::profauth_index>(profauth, s.users, 1),
+      plan<flair::profstat_index>(profstat, std::min(s.users, entries), 1),
+      plan<flair::balance_index>(balance, std::min(s.users, winners), 1),
+      plan<flair::entries_index>(entry, entries, categoryScopes),
+      plan<flair::entryscope_index>(entryscope, entries, 1),
+      plan<flair::contest_index>(contest, contests, categoryScopes),
+      plan<flair::vote_index>(vote, votes, categoryScopes),
+      plan<flair::result_index>(result, contests, 1),
+   };
+}
+
+int main(int argc, char** argv) {
+   scenario s;
+   if (!parseArgs(argc, argv, s)) {
+      usage();
+      return 2;
+   }
+
+   auto tables = project(s);
+
+   std::cout << s.users << " users, " << s.entriesPerUser << " entries per user, " << s.entriesPerContest
+             << " entries per contest, " << s.votesPerEntry << " votes per entry, " << s.categories
+             << " categories (before archival)\n\n";
+   std::cout << std::left << std::setw(13) << "table" << std::right
+             << std::setw(8) << "packed" << std::setw(9) << "indices" << std::setw(11) << "index B"
+             << std::setw(10) << "row B" << std::setw(14) << "rows" << std::setw(16) << "total B" << "\n";
+
+   uint64_t total = 0;
+   for (auto const& t : tables) {
+      total += t.total_bytes();
+      std::cout << std::left << std::setw(13) << t.table << std::right
+                << std::setw(8) << t.packedBytes << std::setw(9) << t.indices << std::setw(11) << t.indexBytes
+                << std::setw(10) << t.row_bytes() << std::setw(14) << t.rows << std::setw(16) << t.total_bytes() << "\n";
+   }
+
+   std::cout << "\nprojected contract RAM: " << total << " bytes (" << std::fixed << std::setprecision(1)
+             << total / (1024.0 * 1024.0) << " MiB), options & cursors not counted" << std::endl;
+   return 0;
+}
@@ -0,0 +1,475 @@
+/*
+   Trace replay - runs a recorded flair action stream through the native build in order & reports, per action
+   and per phase of update, sweeprefunds & migrate, histograms of rows read, rows written, inline actions sent and wall time.
+
+   Input is JSON, one action per line, in either of these shapes:
+      {"time": "2021-05-01T12:00:00.000", "action": "entercontest", "auth": ["alice"], "data": {...}}
+      {"@timestamp": "2021-05-01T12:00:00.000", "act": {"name": "vote", "authorization": [{"actor": "bob"}], "data": {...}}}
+   time may also be seconds since epoch. eosio.token transfers to the contract replay as deposit. Actions the
+   contract sends itself (logentry & lifecycle events) and unknown actions are counted as skipped.
+
+   Build & run with: make replay && ./replay [--contract flair] [--verbose] trace.jsonl
+*/
+#include "flair.cpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+/*
+   JSON values - numbers are kept as text so 64 bit ids survive
+*/
+struct json {
+   enum kind_t { null, boolean, number, string, array, object } kind = null;
+   bool b = false;
+   std::string text;
+   std::vector<json> items;
+   std::vector<std::pair<std::string, json>> fields;
+
+   const json& operator[](const char* key) const {
+      static const json missing;
+      for (auto const& field : fields) {
+         if (field.first == key) {
+            return field.second;
+         }
+      }
+      return missing;
+   }
+
+   bool has(const char* key) const { return (*this)[key].kind != null; }
+};
+
+struct json_parser {
+   std::string_view in;
+   size_t pos = 0;
+
+   void skip_ws() {
+      while (pos < in.size() && std::isspace((unsigned char)in[pos])) { pos++; }
+   }
+
+   char peek() {
+      skip_ws();
+      check(pos < in.size(), "unexpected end of json");
+      return in[pos];
+   }
+
+   void expect(char c) {
+      check(peek() == c, std::string("expected '") + c + "' in json at " + std::to_string(pos));
+      pos++;
+   }
+
+   std::string parse_string() {
+      expect('"');
+      std::string out;
+      while (pos < in.size() && in[pos] != '"') {
+         char c = in[pos++];
+         if (c != '\\') {
+            out += c;
+            continue;
+         }
+         check(pos < in.size(), "unexpected end of json string");
+         char e = in[pos++];
+         switch (e) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+               check(pos + 4 <= in.size(), "bad json unicode escape");
+               uint32_t cp = std::stoul(std::string(in.substr(pos, 4)), nullptr, 16);
+               pos += 4;
+               if (cp < 0x80) {
+                  out += char(cp);
+               } else if (cp < 0x800) {
+                  out += char(0xc0 | cp >> 6);
+                  out += char(0x80 | (cp & 0x3f));
+               } else {
+                  out += char(0xe0 | cp >> 12);
+                  out += char(0x80 | (cp >> 6 & 0x3f));
+                  out += char(0x80 | (cp & 0x3f));
+               }
+               break;
+            }
+            default: out += e; break;
+         }
+      }
+      expect('"');
+      return out;
+   }
+
+   json parse() {
+      json value;
+      char c = peek();
+      if (c == '{') {
+         value.kind = json::object;
+         pos++;
+         if (peek() == '}') { pos++; return value; }
+         while (true) {
+            std::string key = parse_string();
+            expect(':');
+            value.fields.emplace_back(key, parse());
+            if (peek() == ',') { pos++; continue; }
+            expect('}');
+            return value;
+         }
+      } else if (c == '[') {
+         value.kind = json::array;
+         pos++;
+         if (peek() == ']') { pos++; return value; }
+         while (true) {
+            value.items.push_back(parse());
+            if (peek() == ',') { pos++; continue; }
+            expect(']');
+            return value;
+         }
+      } else if (c == '"') {
+         value.kind = json::string;
+         value.text = parse_string();
+      } else if (in.substr(pos, 4) == "true" || in.substr(pos, 5) == "false") {
+         value.kind = json::boolean;
+         value.b = in[pos] == 't';
+         pos += value.b ? 4 : 5;
+      } else if (in.substr(pos, 4) == "null") {
+         pos += 4;
+      } else {
+         value.kind = json::number;
+         size_t start = pos;
+         while (pos < in.size() && (std::isdigit((unsigned char)in[pos]) || std::strchr("+-.eE", in[pos]))) { pos++; }
+         check(pos > start, "bad json value at " + std::to_string(start));
+         value.text = std::string(in.substr(start, pos - start));
+      }
+      return value;
+   }
+};
+
+/*
+   Action data from json - missing fields read as zero
+*/
+static uint64_t juint(const json& v) {
+   if (v.kind == json::boolean) { return v.b; }
+   if (v.kind != json::number && v.kind != json::string) { return 0; }
+   return v.text.empty() ? 0 : std::stoull(v.text);
+}
+
+static std::string jstr(const json& v) { return v.text; }
+static name jname(const json& v) { return name(v.text); }
+static bool jbool(const json& v) { return juint(v) != 0; }
+
+static asset jasset(const json& v) {
+   // "1.0000 EOS"
+   std::string s = v.text;
+   size_t space = s.find(' ');
+   check(space != std::string::npos, "bad asset: " + s);
+   std::string amount = s.substr(0, space);
+   size_t dot = amount.find('.');
+   uint8_t precision = dot == std::string::npos ? 0 : amount.size() - dot - 1;
+   if (dot != std::string::npos) { amount.erase(dot, 1); }
+   return asset(std::stoll(amount), symbol(s.substr(space + 1), precision));
+}
+
+static checksum256 jchecksum(const json& v) {
+   std::array<uint8_t, 32> bytes{};
+   for (size_t i = 0; i + 1 < v.text.size() && i / 2 < bytes.size(); i += 2) {
+      bytes[i / 2] = std::stoul(v.text.substr(i, 2), nullptr, 16);
+   }
+   return checksum256(bytes);
+}
+
+// actions taking one struct argument are recorded as {"params": {...}}
+static const json& jparams(const json& data) {
+   return data.has("params") ? data["params"] : data;
+}
+
+static flair::addprofargs jprofile(const json& v) {
+   flair::addprofargs params;
+   params.id = jname(v["id"]);
+   params.username = jstr(v["username"]);
+   params.imgHash = jchecksum(v["imgHash"]);
+   params.account = jname(v["account"]);
+   params.link = jstr(v["link"]);
+   params.bio = jstr(v["bio"]);
+   params.active = jbool(v["active"]);
+   return params;
+}
+
+static uint32_t jtime(const json& v) {
+   if (v.kind == json::number) {
+      return juint(v);
+   }
+   // 2021-05-01T12:00:00[.000][Z]
+   int y = 0, m = 0, d = 0, hh = 0, mm = 0, ss = 0;
+   check(std::sscanf(v.text.c_str(), "%d-%d-%dT%d:%d:%d", &y, &m, &d, &hh, &mm, &ss) == 6, "bad time: " + v.text);
+   y -= m <= 2;
+   int era = (y >= 0 ? y : y - 399) / 400;
+   unsigned yoe = unsigned(y - era * 400);
+   unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+   unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+   int64_t days = int64_t(era) * 146097 + int64_t(doe) - 719468;
+   return uint32_t(days * 86400 + hh * 3600 + mm * 60 + ss);
+}
+
+/*
+   Histograms - log2 buckets plus percentiles over the raw samples
+*/
+struct metric {
+   std::vector<double> samples;
+
+   void add(double v) { samples.push_back(v); }
+
+   void report(std::ostream& out, const char* label) {
+      if (samples.empty()) { return; }
+      std::sort(samples.begin(), samples.end());
+      double sum = 0;
+      for (auto v : samples) { sum += v; }
+      auto pct = [&](double p) { return samples[std::min(samples.size() - 1, size_t(p * samples.size()))]; };
+
+      out << "   " << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(1)
+          << "mean " << std::setw(8) << sum / samples.size() << "  p50 " << std::setw(8) << pct(0.5)
+          << "  p90 " << std::setw(8) << pct(0.9) << "  p99 " << std::setw(8) << pct(0.99)
+          << "  max " << std::setw(8) << samples.back() << "  |";
+
+      std::map<uint64_t, size_t> buckets;   // upper bound, count
+      for (auto v : samples) {
+         uint64_t bound = 1;
+         while (bound < v) { bound <<= 1; }
+         buckets[v <= 0 ? 0 : bound]++;
+      }
+      for (auto const& bucket : buckets) {
+         out << " <=" << bucket.first << ":" << bucket.second;
+      }
+      out << "\n";
+   }
+};
+
+struct action_stats {
+   size_t runs = 0;
+   size_t failed = 0;
+   std::map<std::string, size_t> errors;
+   metric reads, writes, inlines, wallUs;
+};
+
+struct snapshot {
+   native::db_stats db;
+   size_t inlines;
+   std::chrono::steady_clock::time_point at;
+
+   static snapshot take() {
+      return snapshot{native::host().stats, native::host().inlineActions.size(), std::chrono::steady_clock::now()};
+   }
+};
+
+static void record(action_stats& stats, const snapshot& from, const snapshot& to) {
+   stats.runs++;
+   stats.reads.add(to.db.lookups + to.db.steps - from.db.lookups - from.db.steps);
+   stats.writes.add(to.db.writes - from.db.writes);
+   stats.inlines.add(to.inlines - from.inlines);
+   stats.wallUs.add(std::chrono::duration<double, std::micro>(to.at - from.at).count());
+}
+
+int main(int argc, char** argv) {
+   name contractAccount = name("flair");
+   bool verbose = false;
+   const char* path = nullptr;
+   for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg == "--contract" && i + 1 < argc) {
+         contractAccount = name(std::string(argv[++i]));
+      } else if (arg == "--verbose") {
+         verbose = true;
+      } else {
+         path = argv[i];
+      }
+   }
+   if (!path) {
+      std::cerr << "usage: replay [--contract flair] [--verbose] trace.jsonl" << std::endl;
+      return 2;
+   }
+
+   std::ifstream in(path);
+   if (!in) {
+      std::cerr << "cannot open " << path << std::endl;
+      return 2;
+   }
+
+   native::host().receiver = contractAccount;
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   std::map<std::string, action_stats> actions;
+   std::map<std::string, action_stats> phases;
+   std::map<std::string, size_t> skipped;
+
+   // update, sweeprefunds & migrate print "<phase> completed" after each of their phases
+   std::string currentAction;
+   snapshot phaseStart;
+   native::host().printSink = [&](const char* text) {
+      static const std::string marker = " completed \n";
+      std::string_view line(text);
+      if (line.size() <= marker.size() || line.substr(line.size() - marker.size()) != marker) { return; }
+      auto now = snapshot::take();
+      record(phases[currentAction + "/" + std::string(line.substr(0, line.size() - marker.size()))], phaseStart, now);
+      phaseStart = snapshot::take();
+   };
+
+   std::string line;
+   size_t lineNumber = 0;
+   while (std::getline(in, line)) {
+      lineNumber++;
+      if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+
+      json entry;
+      try {
+         entry = json_parser{line}.parse();
+      } catch (const check_failure& e) {
+         std::cerr << path << ":" << lineNumber << ": " << e.what() << std::endl;
+         return 1;
+      }
+
+      const json& act = entry.has("act") ? entry["act"] : entry;
+      std::string actionName = jstr(act.has("action") ? act["action"] : act["name"]);
+      const json& data = act["data"];
+
+      for (const char* key : {"time", "block_time", "@timestamp", "timestamp"}) {
+         if (entry.has(key)) {
+            native::host().set_time(jtime(entry[key]));
+            break;
+         }
+      }
+
+      std::vector<name> auths;
+      for (auto const& auth : (act.has("auth") ? act["auth"] : act["authorization"]).items) {
+         auths.push_back(jname(auth.kind == json::object ? auth["actor"] : auth));
+      }
+      if (auths.empty()) {
+         auths.push_back(contractAccount);
+      }
+      native::host().authorize(auths);
+
+      std::function<void()> run;
+      if (actionName == "transfer" || actionName == "deposit") {
+         run = [&]() { contract.deposit(jname(data["from"]), jname(data["to"]), jasset(data["quantity"]), jstr(data["memo"])); };
+      } else if (actionName == "entercontest") {
+         run = [&]() {
+            const json& params = jparams(data);
+            flair::contestargs args{};
+            args.id = jname(params["id"]);
+            args.userId = jname(params["userId"]);
+            args.levelId = jname(params["levelId"]);
+            args.videoHash720p = jchecksum(params["videoHash720p"]);
+            args.videoHash1080p = jchecksum(params["videoHash1080p"]);
+            args.coverHash = jchecksum(params["coverHash"]);
+            contract.entercontest(args);
+         };
+      } else if (actionName == "vote") {
+         run = [&]() { contract.vote(jname(data["voterUserId"]), jname(data["entryId"])); };
+      } else if (actionName == "votebatch") {
+         run = [&]() {
+            std::vector<name> entryIds;
+            for (auto const& id : data["entryIds"].items) { entryIds.push_back(jname(id)); }
+            contract.votebatch(jname(data["voterUserId"]), entryIds);
+         };
+      } else if (actionName == "addcurhigh") {
+         run = [&]() { contract.addcurhigh(juint(data["openTime"]), juint(data["usdHigh"]), juint(data["intervalSec"])); };
+      } else if (actionName == "update") {
+         run = [&]() { contract.update(); };
+      } else if (actionName == "sweeprefunds") {
+         run = [&]() { contract.sweeprefunds(); };
+      } else if (actionName == "migrate") {
+         run = [&]() { contract.migrate(jname(data["table"])); };
+      } else if (actionName == "refundentry") {
+         run = [&]() { contract.refundentry(jname(data["id"]), jname(data["to"]), jstr(data["memo"])); };
+      } else if (actionName == "claim") {
+         run = [&]() { contract.claim(jname(data["profileId"]), jasset(data["amount"]), jname(data["to"]), jstr(data["memo"])); };
+      } else if (actionName == "blkentry") {
+         run = [&]() { contract.blkentry(jname(data["id"])); };
+      } else if (actionName == "unblkentry") {
+         run = [&]() { contract.unblkentry(jname(data["id"])); };
+      } else if (actionName == "createcat") {
+         run = [&]() { contract.createcat(jname(data["id"]), jstr(data["name"]), juint(data["maxVideoLength"])); };
+      } else if (actionName == "createlevel") {
+         run = [&]() {
+            const json& params = jparams(data);
+            flair::createlvlargs args{};
+            args.id = jname(params["id"]);
+            args.categoryId = jname(params["categoryId"]);
+            args.name = jstr(params["name"]);
+            args.price = juint(params["price"]);
+            args.participantLimit = juint(params["participantLimit"]);
+            args.submissionPeriod = juint(params["submissionPeriod"]);
+            args.votePeriod = juint(params["votePeriod"]);
+            args.fee = juint(params["fee"]);
+            for (auto const& prize : params["prizes"].items) { args.prizes.push_back(juint(prize)); }
+            args.fixedPrize = juint(params["fixedPrize"]);
+            args.allowedSimultaneousContests = juint(params["allowedSimultaneousContests"]);
+            args.voteStartUTCHour = juint(params["voteStartUTCHour"]);
+            args.minParticipant = juint(params["minParticipant"]);
+            contract.createlevel(args);
+         };
+      } else if (actionName == "addprofile") {
+         run = [&]() { contract.addprofile(jprofile(jparams(data))); };
+      } else if (actionName == "addprofiles") {
+         run = [&]() {
+            std::vector<flair::addprofargs> profiles;
+            for (auto const& profile : data["params"].items) { profiles.push_back(jprofile(profile)); }
+            contract.addprofiles(profiles);
+         };
+      } else if (actionName == "setcurrency") {
+         run = [&]() { contract.setcurrency(jstr(data["curSymbol"])); };
+      } else if (actionName == "setentryexp") {
+         run = [&]() { contract.setentryexp(juint(data["exp"])); };
+      } else if (actionName == "setpricefrsh") {
+         run = [&]() { contract.setpricefrsh(juint(data["freshness"])); };
+      } else if (actionName == "setarchbudg") {
+         run = [&]() { contract.setarchbudg(juint(data["budget"])); };
+      } else if (actionName == "setentryarch") {
+         run = [&]() { contract.setentryarch(juint(data["sec"])); };
+      } else if (actionName == "setfeeacct") {
+         run = [&]() { contract.setfeeacct(jname(data["account"]), jstr(data["memo"])); };
+      } else {
+         skipped[actionName]++;
+         continue;
+      }
+
+      auto& stats = actions[actionName];
+      native::host().stats = native::db_stats{};
+      native::host().inlineActions.clear();
+      currentAction = actionName;
+      auto start = snapshot::take();
+      phaseStart = start;
+      try {
+         native::host().apply(run);
+         record(stats, start, snapshot::take());
+      } catch (const check_failure& e) {
+         record(stats, start, snapshot::take());
+         stats.failed++;
+         stats.errors[e.what()]++;
+         if (verbose) {
+            std::cerr << path << ":" << lineNumber << ": " << actionName << " failed: " << e.what() << std::endl;
+         }
+      }
+   }
+
+   std::cout << "replayed " << path << "\n";
+   for (auto* group : {&actions, &phases}) {
+      for (auto& item : *group) {
+         auto& stats = item.second;
+         std::cout << "== " << item.first << "  " << stats.runs << " runs";
+         if (stats.failed > 0) {
+            std::cout << ", " << stats.failed << " failed";
+         }
+         std::cout << "\n";
+         stats.reads.report(std::cout, "rows read");
+         stats.writes.report(std::cout, "rows written");
+         stats.inlines.report(std::cout, "inline actions");
+         stats.wallUs.report(std::cout, "wall us");
+         for (auto const& error : stats.errors) {
+            std::cout << "   failed x" << error.second << ": " << error.first << "\n";
+         }
+      }
+   }
+   for (auto const& skip : skipped) {
+      std::cout << "skipped " << skip.first << " x" << skip.second << "\n";
+   }
+   return 0;
+}
@@ -0,0 +1,106 @@
+/*
+   Legacy entry tests - entries written under the index layout before byvideo are rewritten by update &
+   sweeprefunds, then archived or refunded like any other entry without leaving index rows behind.
+   Build & run with: make test
+*/
+#include <eosio/eosio.hpp>
+
+#include <iostream>
+
+// the table structs are private to the contract
+#define private public
+#include "flair.cpp"
+#undef private
+
+static name contractAccount = name("flair");
+static name music = name("music");
+
+// index rows of the entries table in music's scope, one db_idx* table per index number & key type
+static size_t indexRows(uint64_t index, uint64_t keyType) {
+   uint64_t table = (name("entries").value & 0xFFFFFFFFFFFFFFF0ULL) | index;
+   auto itr = native::host().tables.find(native::table_key{contractAccount.value, music.value, table, keyType});
+   return itr == native::host().tables.end() ? 0 : itr->second->row_count();
+}
+
+static size_t legacyIndexRows() {
+   return indexRows(3, 3) + indexRows(4, 3) + indexRows(5, 1);
+}
+
+static void addLegacyEntry(const char* id, uint64_t amount, uint32_t createdAt) {
+   flair::legacy_entries_index legacyEntries(contractAccount, music.value);
+   legacyEntries.emplace(contractAccount, [&](flair::contestEntry& row) {
+      row.id = name(id);
+      row.userId = name("ua");
+      row.levelId = name("gold");
+      row.amount = amount;
+      row.open = true;
+      row.videoHash720p = sha256(id, 3);
+      row.createdAt = createdAt;
+   });
+
+   flair::entryscope_index entryscopes(contractAccount, contractAccount.value);
+   entryscopes.emplace(contractAccount, [&](flair::entryscope& row) {
+      row.id = name(id);
+      row.categoryId = music;
+   });
+}
+
+int main() {
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   contract.createcat(music, "Music", 30);
+   contract.setcurrency("EOS");
+   contract.setentryexp(3600);
+   contract.setpricefrsh(3600);
+
+   flair::createlvlargs level{};
+   level.id = name("gold");
+   level.categoryId = music;
+   level.name = "Gold";
+   level.participantLimit = 10;
+   level.submissionPeriod = 100;
+   level.votePeriod = 100;
+   level.prizes = {100};
+   contract.createlevel(level);
+
+   flair::addprofargs profile;
+   profile.id = name("ua");
+   profile.username = "userua";
+   profile.account = profile.id;
+   profile.active = true;
+   contract.addprofile(profile);
+
+   // an unpaid entry for archival, a funded one for the refund sweep
+   uint32_t createdAt = native::host().now - 3 * 86400;
+   addLegacyEntry("eunpaid", 0, createdAt);
+   addLegacyEntry("efunded", 20000, createdAt);
+   check(legacyIndexRows() == 6, "legacy index rows not written");
+   check(indexRows(4, 1) == 0, "legacy entries are not in the current bycreatedat index");
+
+   // the budget covers one rewrite, the sweeps of the scope wait for the other
+   contract.setarchbudg(flair::archiveCostReindex);
+   contract.update();
+   check(legacyIndexRows() == 3, "one legacy entry should be rewritten");
+   check(indexRows(4, 1) == 1, "rewritten entry not in the current bycreatedat index");
+   check(native::host().row_count(contractAccount, music, name("entries")) == 2, "no entry may be archived yet");
+
+   contract.setarchbudg(0);
+   native::host().inlineActions.clear();
+   contract.sweeprefunds();
+   check(legacyIndexRows() == 0, "legacy entries left after the sweep");
+   check(native::host().inlineActions.size() == 1, "funded legacy entry should be refunded once");
+
+   contract.update();
+   check(native::host().row_count(contractAccount, music, name("entries")) == 0, "unpaid legacy entry not archived");
+   check(native::host().row_count(contractAccount, contractAccount, name("entryscopes")) == 0, "entryscopes rows left");
+   for (uint64_t index = 0; index < 6; index++) {
+      for (uint64_t keyType = 1; keyType <= 3; keyType++) {
+         check(indexRows(index, keyType) == 0, "index rows left behind");
+      }
+   }
+
+   std::cout << "legacy entries ok" << std::endl;
+   return 0;
+}
@@ -0,0 +1,98 @@
+/*
+   Legacy profile tests - profiles written before the byaccount index have no row in it, editprofadm & migrate
+   write them again so the account checks see them.
+   Build & run with: make test
+*/
+#include <eosio/eosio.hpp>
+
+#include <iostream>
+
+// the table structs are private to the contract
+#define private public
+#include "flair.cpp"
+#undef private
+
+static name contractAccount = name("flair");
+
+// the profiles layout before byaccount
+typedef eosio::multi_index<
+   name("profiles"),
+   flair::profile,
+   indexed_by<name("byusername"), const_mem_fun<flair::profile, checksum256, &flair::profile::by_username_hash>>
+> legacy_profile_index;
+
+// rows of the byaccount index, slot 1 of the profiles table
+static size_t accountIndexRows() {
+   uint64_t table = (name("profiles").value & 0xFFFFFFFFFFFFFFF0ULL) | 1;
+   auto itr = native::host().tables.find(native::table_key{contractAccount.value, contractAccount.value, table, 1});
+   return itr == native::host().tables.end() ? 0 : itr->second->row_count();
+}
+
+static void addLegacyProfile(flair& contract, const char* id) {
+   legacy_profile_index legacyProfiles(contractAccount, contractAccount.value);
+   legacyProfiles.emplace(contractAccount, [&](flair::profile& row) {
+      row.id = name(id);
+      row.username = std::string("user") + id;
+      row.usernameHash = contract.hashUsername(row.username);
+      row.account = name(id);
+      row.active = true;
+   });
+}
+
+static bool rejected(std::function<void()> action) {
+   try {
+      action();
+   } catch (const check_failure&) {
+      return true;
+   }
+   return false;
+}
+
+static flair::addprofargs profileArgs(const char* id, const char* account) {
+   flair::addprofargs params;
+   params.id = name(id);
+   params.username = std::string("user") + id;
+   params.account = name(account);
+   params.active = true;
+   return params;
+}
+
+int main() {
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   addLegacyProfile(contract, "ua");
+   addLegacyProfile(contract, "ub");
+   addLegacyProfile(contract, "uc");
+   check(accountIndexRows() == 0, "legacy profiles are not in the byaccount index");
+
+   // editprofadm writes the legacy profile again before moving it to another account
+   flair::editprofargsa data{"userua", checksum256(), name("ud"), "", "", true};
+   contract.editprofadm(name("ua"), data);
+   check(accountIndexRows() == 1, "edited profile not in the byaccount index");
+   check(contract.profbyacct(name("ud")).id == name("ua"), "edited profile not found by its new account");
+
+   // the budget covers one rewrite, the next call finishes the table
+   contract.setarchbudg(flair::migrateCostReindex);
+   check(!contract.migrate(name("profiles")), "migrate should stop at the budget");
+   check(accountIndexRows() == 2, "one legacy profile should be rewritten");
+   contract.setarchbudg(0);
+   check(contract.migrate(name("profiles")), "migrate should finish the profiles");
+   check(accountIndexRows() == 3, "legacy profiles left out of the byaccount index");
+
+   // plain text profiles are versioned behind a zeroed text
+   flair::profile_index profiles(contractAccount, contractAccount.value);
+   for (auto const& row : profiles) {
+      check(row.schemaVersion.value_or(0) == flair::profileSchemaVersion, "migrated profile not versioned");
+      check(row.text.has_value() && row.text->linkLength == 0 && row.text->bioHash == checksum256(), "plain profile text not zeroed");
+   }
+
+   check(rejected([&]() { contract.addprofile(profileArgs("ue", "uc")); }), "account of a legacy profile reused");
+   check(rejected([&]() { contract.editprofadm(name("ub"), {"userub", checksum256(), name("uc"), "", "", true}); }),
+      "account of a legacy profile taken over");
+   check(contract.profbyacct(name("ub")).id == name("ub"), "migrated profile not found by account");
+
+   std::cout << "legacy profiles ok" << std::endl;
+   return 0;
+}
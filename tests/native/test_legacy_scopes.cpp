@@ -0,0 +1,111 @@
+/*
+   Legacy scope tests - entries stored in the contract's own scope before the category scopes open their
+   contests there when paid. The level's contest limit & the one entry per contest check cover both scopes.
+   Build & run with: make test
+*/
+#include <eosio/eosio.hpp>
+
+#include <iostream>
+
+// the table structs are private to the contract
+#define private public
+#include "flair.cpp"
+#undef private
+
+static name contractAccount = name("flair");
+static name music = name("music");
+
+// entries stored before the category scopes have no entryscopes row
+static void addLegacyEntry(const char* id, const char* userId, const char* levelId) {
+   flair::entries_index legacyEntries(contractAccount, contractAccount.value);
+   legacyEntries.emplace(contractAccount, [&](flair::contestEntry& row) {
+      row.id = name(id);
+      row.userId = name(userId);
+      row.levelId = name(levelId);
+      row.open = true;
+      row.videoHash720p = sha256(id, strlen(id));
+      row.createdAt = native::host().now;
+   });
+}
+
+static flair::contestargs entryArgs(const char* id, const char* userId, const char* levelId) {
+   flair::contestargs params{};
+   params.id = name(id);
+   params.userId = name(userId);
+   params.levelId = name(levelId);
+   params.videoHash720p = sha256(id, strlen(id));
+   return params;
+}
+
+static bool rejected(std::function<void()> action) {
+   try {
+      action();
+   } catch (const check_failure&) {
+      return true;
+   }
+   return false;
+}
+
+int main() {
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   contract.createcat(music, "Music", 30);
+   contract.setcurrency("EOS");
+   contract.setentryexp(3600);
+   contract.setpricefrsh(3600);
+
+   // free levels, a paid entry joins without a price
+   for (auto id : {"solo", "gold"}) {
+      flair::createlvlargs level{};
+      level.id = name(id);
+      level.categoryId = music;
+      level.name = id;
+      level.participantLimit = std::string(id) == "solo" ? 1 : 10;
+      level.allowedSimultaneousContests = std::string(id) == "solo" ? 1 : 0;
+      level.submissionPeriod = 100;
+      level.votePeriod = 100;
+      level.prizes = {100};
+      contract.createlevel(level);
+   }
+
+   for (auto id : {"ua", "ub", "uc"}) {
+      flair::addprofargs profile;
+      profile.id = name(id);
+      profile.username = std::string("user") + id;
+      profile.account = name(id);
+      profile.active = true;
+      contract.addprofile(profile);
+   }
+
+   addLegacyEntry("esolo1", "ua", "solo");
+   addLegacyEntry("egold", "ua", "gold");
+   for (auto id : {"esolo1", "egold"}) {
+      contract.deposit(name("ua"), contractAccount, asset(10000, symbol("EOS", 4)), id);
+   }
+   check(native::host().row_count(contractAccount, contractAccount, name("contests")) == 2, "legacy entries should open contests in the contract's scope");
+   check(native::host().row_count(contractAccount, music, name("contests")) == 0, "no contest expected in music yet");
+
+   // the legacy gold entry's contest is still taking submissions
+   native::host().authorize({name("ua")});
+   check(rejected([&]() { contract.entercontest(entryArgs("eagold", "ua", "gold")); }), "legacy entry should count as already entered");
+
+   // the first solo contest is voting & the next one is full, together they reach the level's limit
+   native::host().advance(101);
+   addLegacyEntry("esolo2", "ub", "solo");
+   contract.deposit(name("ub"), contractAccount, asset(10000, symbol("EOS", 4)), "esolo2");
+   check(native::host().row_count(contractAccount, contractAccount, name("contests")) == 3, "second solo contest not opened");
+   native::host().authorize({name("uc")});
+   check(rejected([&]() { contract.entercontest(entryArgs("ecsolo", "uc", "solo")); }), "contest limit should count the contract's scope");
+
+   // once voting started the legacy entry is closed & the new one joins a contest in music
+   native::host().authorize({name("ua")});
+   check(contract.entercontest(entryArgs("eagold", "ua", "gold")).status == name("active"), "new entry should be taken");
+   flair::entries_index legacyEntries(contractAccount, contractAccount.value);
+   check(!legacyEntries.get(name("egold").value).open, "legacy entry should be closed");
+   check(native::host().row_count(contractAccount, music, name("contests")) == 1, "new entry's contest should be in music");
+
+   std::cout << "legacy scopes ok" << std::endl;
+   return 0;
+}
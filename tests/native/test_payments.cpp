@@ -0,0 +1,43 @@
+/*
+   Payments tests - the payments contract reads the currency option of the contest contract, only transfers in
+   that currency are forwarded as fund.
+   Build & run with: make test
+*/
+#include <eosio/eosio.hpp>
+
+#include <iostream>
+
+#include "flair.cpp"
+#include "../payments/src/flairpay.cpp"
+
+static name contestsAccount = name("flair");
+static name paymentsAccount = name("flairpay");
+
+static size_t forwardedFunds() {
+   size_t count = 0;
+   for (auto const& action : native::host().inlineActions) {
+      if (action.account == contestsAccount && action.action == name("fund")) { count++; }
+   }
+   return count;
+}
+
+int main() {
+   native::host().receiver = contestsAccount;
+   native::host().authorize({contestsAccount});
+   flair contests(contestsAccount, contestsAccount, datastream<const char*>(nullptr, 0));
+   contests.setcurrency("EOS");
+
+   native::host().receiver = paymentsAccount;
+   native::host().authorize({paymentsAccount});
+   flairpay payments(paymentsAccount, name("eosio.token"), datastream<const char*>(nullptr, 0));
+   payments.setcontests(contestsAccount);
+
+   payments.deposit(name("alice"), paymentsAccount, asset(10000, symbol("SYS", 4)), "prizefund");
+   check(forwardedFunds() == 0, "transfer in another currency forwarded");
+
+   payments.deposit(name("alice"), paymentsAccount, asset(10000, symbol("EOS", 4)), "prizefund");
+   check(forwardedFunds() == 1, "transfer in the contest currency not forwarded");
+
+   std::cout << "payments ok" << std::endl;
+   return 0;
+}
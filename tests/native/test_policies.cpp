@@ -0,0 +1,248 @@
+/*
+   Contest policy tests - checks every schedule, payout & entry pricing policy on its own, then settles a fixed
+   prize level & a paid entry pool level through the contract so both activation & settlement instantiations run,
+   and enters a free contest left open on a level made paid.
+   Build & run with: make test
+*/
+#include <eosio/eosio.hpp>
+
+#include <iostream>
+
+// the table structs are private to the contract
+#define private public
+#include "flair.cpp"
+#undef private
+
+static name contractAccount = name("flair");
+static symbol eos = symbol("EOS", 4);
+
+static const uint32_t day = 86400;
+static const uint32_t createdAt = 20000 * day + 10 * 3600 + 125; // 10:02:05 UTC
+
+static flair::contest sampleContest() {
+   flair::contest c{};
+   c.createdAt = createdAt;
+   c.submissionPeriod = 600;
+   c.participantCount = 1;
+   return c;
+}
+
+template<typename expectedT>
+static void checkSelected(const flair::contest& c, const char* msg) {
+   bool selected = withSchedule(c, [&](auto schedule) { return std::is_same_v<decltype(schedule), expectedT>; });
+   check(selected, msg);
+}
+
+static void testSchedules() {
+   flair::contest c = sampleContest();
+   checkSelected<plainSchedule>(c, "plain schedule not selected");
+   check(c.votestarttime() == createdAt + 600, "plain schedule starts the vote after the submission period");
+   check(plainSchedule::voteStartReached(c), "plain schedule reaches the vote start with the first entry");
+
+   c.voteStartUTCHour = 14;
+   checkSelected<hourSchedule>(c, "hour schedule not selected");
+   check(c.votestarttime() == 20000 * day + 14 * 3600, "hour schedule starts the vote later the same day");
+   c.voteStartUTCHour = 8;
+   check(c.votestarttime() == 20001 * day + 8 * 3600, "hour schedule starts the vote the next day");
+   c.voteStartUTCHour = 10;
+   check(c.votestarttime() == 20001 * day + 10 * 3600, "hour schedule skips the hour the contest was created in");
+
+   c = sampleContest();
+   c.minParticipant = 3;
+   checkSelected<minimumSchedule>(c, "minimum schedule not selected");
+   check(c.votestarttime() == minimumSchedule::notScheduled, "minimum schedule waits for the minimum");
+   check(!minimumSchedule::voteStartReached(c), "minimum schedule reached below the minimum");
+
+   c.participantCount = 3;
+   minimumSchedule::entryAdded(c, createdAt + 100);
+   check(c.lastEntryAddedAt == 0, "minimum reached within the submission period keeps the period");
+   check(c.votestarttime() == createdAt + 600, "minimum schedule starts the vote after the submission period");
+   check(minimumSchedule::voteStartReached(c), "minimum schedule not reached at the minimum");
+
+   minimumSchedule::entryAdded(c, createdAt + 900);
+   check(c.lastEntryAddedAt == createdAt + 900, "late entry reaching the minimum starts the vote");
+   check(c.votestarttime() == createdAt + 900, "minimum schedule starts the vote at the last entry");
+}
+
+static void testPayouts() {
+   asset payments(60000, eos);
+   check(entryPoolPayout::prizePool(payments, 0) == payments, "entry pool pays out the entry payments");
+   check(entryPoolPayout::fee(payments, 100) == asset(6000, eos), "entry pool takes the level fee");
+   check(!entryPoolPayout::usesPrizeFund, "entry pool uses the prize fund");
+
+   check(prizeFundPayout::prizePool(payments, 20000) == asset(20000, eos), "prize fund pays out the fixed prize");
+   check(prizeFundPayout::fee(asset(20000, eos), 100) == asset(0, eos), "prize fund takes a fee");
+   check(prizeFundPayout::usesPrizeFund, "prize fund payout does not use the prize fund");
+
+   check(withPayout(true, [](auto payout) { return decltype(payout)::usesPrizeFund; }), "prize fund payout not selected");
+   check(!withPayout(false, [](auto payout) { return decltype(payout)::usesPrizeFund; }), "entry pool payout not selected");
+
+   check(withPricing(true, [](auto pricing) { return decltype(pricing)::activatesOnEnter; }), "free entry not selected");
+   check(!withPricing(false, [](auto pricing) { return decltype(pricing)::activatesOnEnter; }), "paid entry not selected");
+}
+
+/*
+   Contract runs - three entries with 3, 2 & 1 votes on one level, settled through update
+*/
+static flair::contestresult settleLevel(const char* levelId, uint32_t price, uint32_t fixedPrize) {
+   native::host() = native::host_state{};
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   contract.createcat(name("music"), "Music", 30);
+   contract.setcurrency("EOS");
+   contract.setentryexp(3600);
+   contract.setpricefrsh(3600);
+   contract.addcurhigh(native::host().now - 10, 50000, 3600);
+   contract.deposit(name("funder"), contractAccount, asset(1000000, eos), "prizefund");
+
+   flair::createlvlargs level{};
+   level.id = name(levelId);
+   level.categoryId = name("music");
+   level.name = levelId;
+   level.price = price;
+   level.participantLimit = 3;
+   level.submissionPeriod = 100;
+   level.votePeriod = 100;
+   level.fee = 100;
+   level.prizes = {50, 30, 20};
+   level.fixedPrize = fixedPrize;
+   contract.createlevel(level);
+
+   const char* users[] = {"ua", "ub", "uc", "ud", "ue", "uf"};
+   for (auto user : users) {
+      flair::addprofargs params;
+      params.id = name(user);
+      params.username = std::string("user") + user;
+      params.account = params.id;
+      params.active = true;
+      contract.addprofile(params);
+   }
+
+   for (int i = 0; i < 3; i++) {
+      native::host().authorize({name(users[i])});
+      flair::contestargs params{};
+      params.id = name(std::string("e") + users[i]);
+      params.userId = name(users[i]);
+      params.levelId = level.id;
+      params.videoHash720p = sha256(users[i], 2);
+      auto result = contract.entercontest(params);
+      check(result.status == name(price > 0 ? "unpaid" : "active"), "unexpected entry status");
+      if (price > 0) {
+         // $10 at $5 per EOS
+         contract.deposit(name(users[i]), contractAccount, asset(20000, eos), params.id.to_string());
+      }
+   }
+
+   native::host().advance(level.submissionPeriod + 1);
+   const char* votes[][2] = {{"ua", "eua"}, {"ud", "eua"}, {"ue", "eua"}, {"ub", "eub"}, {"uf", "eub"}, {"uc", "euc"}};
+   for (auto vote : votes) {
+      native::host().authorize({name(vote[0])});
+      contract.vote(name(vote[0]), name(vote[1]));
+   }
+
+   native::host().advance(level.votePeriod + 1);
+   native::host().authorize({contractAccount});
+   contract.update();
+
+   flair::result_index results(contractAccount, contractAccount.value);
+   check(results.begin() != results.end(), "contest was not settled");
+   return *results.begin();
+}
+
+static void checkWinners(const flair::contestresult& result, std::vector<int64_t> prizes) {
+   check(result.winners.size() == prizes.size(), "unexpected winner count");
+   const char* entries[] = {"eua", "eub", "euc"};
+   for (size_t i = 0; i < prizes.size(); i++) {
+      check(result.winners[i].entryId == name(entries[i]), "winners out of order");
+      check(result.winners[i].prize == asset(prizes[i], eos), "unexpected prize");
+   }
+}
+
+static void testFixedPrizeLevel() {
+   // $10 fixed prize at $5 per EOS, reserved from the prize fund, no fee
+   auto result = settleLevel("fixed", 0, 1000);
+   check(result.prizePool == asset(20000, eos), "fixed prize pool");
+   check(result.fee == asset(0, eos), "fixed prize levels take no fee");
+   checkWinners(result, {10000, 6000, 4000});
+}
+
+static void testEntryPoolLevel() {
+   // three $10 entries, 10% fee, 90% split 50/30/20
+   auto result = settleLevel("paid", 1000, 0);
+   check(result.prizePool == asset(60000, eos), "entry pool prize");
+   check(result.fee == asset(6000, eos), "entry pool fee");
+   checkWinners(result, {27000, 16200, 10800});
+}
+
+/*
+   A free level made paid keeps its open contest free, entries to it activate instead of waiting for a payment
+*/
+static void testFreeContestOnPaidLevel() {
+   native::host() = native::host_state{};
+   native::host().receiver = contractAccount;
+   native::host().authorize({contractAccount});
+   flair contract(contractAccount, contractAccount, datastream<const char*>(nullptr, 0));
+
+   contract.createcat(name("music"), "Music", 30);
+   contract.setcurrency("EOS");
+   contract.setentryexp(3600);
+   contract.setpricefrsh(3600);
+
+   flair::createlvlargs level{};
+   level.id = name("open");
+   level.categoryId = name("music");
+   level.name = "open";
+   level.participantLimit = 3;
+   level.submissionPeriod = 100;
+   level.votePeriod = 100;
+   level.prizes = {100};
+   contract.createlevel(level);
+
+   const char* users[] = {"ua", "ub", "uc"};
+   for (auto user : users) {
+      flair::addprofargs params;
+      params.id = name(user);
+      params.username = std::string("user") + user;
+      params.account = params.id;
+      params.active = true;
+      contract.addprofile(params);
+   }
+
+   auto enter = [&](const char* user) {
+      native::host().authorize({name(user)});
+      flair::contestargs params{};
+      params.id = name(std::string("e") + user);
+      params.userId = name(user);
+      params.levelId = level.id;
+      params.videoHash720p = sha256(user, 2);
+      auto result = contract.entercontest(params);
+      native::host().authorize({contractAccount});
+      return result;
+   };
+
+   check(enter("ua").status == name("active"), "free level entry not active");
+
+   flair::editlevelargs data{"open", false, 1000, 3, 100, 100, 0, {100}, 0, 0, 0, 0};
+   contract.editlevel(level.id, data);
+   auto result = enter("ub");
+   check(result.status == name("active"), "entry to a free contest reported unpaid");
+   check(result.amountOwed == 0 && result.contestId != 0, "free contest entry not placed");
+
+   // no price high yet, the next contest is paid
+   native::host().advance(level.submissionPeriod + 1);
+   result = enter("uc");
+   check(result.status == name("priceunavail"), "paid entry without a price high reported unpaid");
+   check(result.amountOwed == 0 && result.contestId == 0, "paid entry placed without a payment");
+}
+
+int main() {
+   testSchedules();
+   testPayouts();
+   testFixedPrizeLevel();
+   testEntryPoolLevel();
+   testFreeContestOnPaidLevel();
+   std::cout << "contest policies ok" << std::endl;
+   return 0;
+}
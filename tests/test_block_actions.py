@@ -74,6 +74,10 @@ class BlockActionsUnitTest(unittest.TestCase):
             force_unique=1
         )
 
+    def randomVideoHash(self):
+        # entercontest rejects a video already entered, so every entry needs its own
+        return "%064x" % random.getrandbits(256)
+
     def randomEOSIOId(self):
         allowChar = "abcdefghijklmnopqrstuvwxyz12345."
         
@@ -292,7 +296,6 @@ class BlockActionsUnitTest(unittest.TestCase):
 
         self.videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        self.videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -305,7 +308,7 @@ class BlockActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -321,7 +324,7 @@ class BlockActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -337,7 +340,7 @@ class BlockActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -414,18 +417,85 @@ class BlockActionsUnitTest(unittest.TestCase):
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
-        HOST.table("contests", HOST)
-        HOST.table("entries", HOST)
-        bobBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        HOST.table("contests", "music")
+        HOST.table("entries", "music")
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
         HOST.push_action("blkentry", { "id": self.entryId2 }, force_unique=True, permission=(HOST, Permission.ACTIVE))
 
-        bobAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
-        HOST.table("contests", HOST)
-        HOST.table("entries", HOST)
+        HOST.table("contests", "music")
+        HOST.table("entries", "music")
         self.assertAlmostEqual(bobAfterBal - bobBeforeBal, -4.011)
+
+        bobStats = HOST.table("profstats", HOST, lower=self.userId2, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(bobStats["entries"], 1)
+        self.assertEqual(bobStats["votesReceived"], 2)
+        self.assertEqual(bobStats["contestsWon"], 1)
+        self.assertEqual(bobStats["revocations"], 1)
+        self.assertEqual(bobStats["winnings"], "0.0000 EOS")
     
+    def test_block_entries_batch_action(self):
+        for (ACCT, entryId) in [(self.ALICE, self.entryId), (self.BOB, self.entryId2), (self.CAROL, self.entryId3)]:
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ACCT,
+                    "to": HOST,
+                    "quantity": "2.0000 EOS", 
+                    "memo": entryId,
+                },
+                force_unique=True,
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        time.sleep(5)
+
+        HOST.push_action(
+            "vote",
+            {
+                "entryId": self.entryId2,
+                "voterUserId": self.userId3,
+            },
+            permission=(self.CAROL, Permission.ACTIVE)
+        )
+
+        time.sleep(4)
+
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+
+        entry = HOST.table("entries", "music", lower=self.entryId2, key_type="name", limit=1).json["rows"][0]
+        contestBefore = HOST.table("contests", "music", lower=entry["contestId"], limit=1).json["rows"][0]
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
+
+        # unknown & repeated ids are reported in the return value rather than failing the batch
+        HOST.push_action(
+            "blkentries",
+            { "ids": [self.entryId2, self.entryId3, self.entryId2, self.randomEOSIOId()] },
+            force_unique=True,
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
+        contestAfter = HOST.table("contests", "music", lower=entry["contestId"], limit=1).json["rows"][0]
+        entryAfter = HOST.table("entries", "music", lower=self.entryId2, key_type="name", limit=1).json["rows"][0]
+
+        self.assertEqual(contestAfter["participantCount"], contestBefore["participantCount"] - 2)
+        self.assertEqual(entryAfter["block"], 1)
+        self.assertEqual(entryAfter["prizeRevoked"], 1)
+        self.assertLess(bobAfterBal, bobBeforeBal)
+
+        HOST.push_action(
+            "unblkentries",
+            { "ids": [self.entryId2, self.entryId3] },
+            force_unique=True,
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        contestAfter = HOST.table("contests", "music", lower=entry["contestId"], limit=1).json["rows"][0]
+        self.assertEqual(contestAfter["participantCount"], contestBefore["participantCount"])
+
     @classmethod
     def tearDownClass(cls):
         stop()
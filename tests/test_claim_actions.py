@@ -74,6 +74,10 @@ class UpdateActionsUnitTest(unittest.TestCase):
             force_unique=1
         )
 
+    def randomVideoHash(self):
+        # entercontest rejects a video already entered, so every entry needs its own
+        return "%064x" % random.getrandbits(256)
+
     def randomEOSIOId(self):
         allowChar = "abcdefghijklmnopqrstuvwxyz12345."
         
@@ -302,7 +306,6 @@ class UpdateActionsUnitTest(unittest.TestCase):
 
         self.videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        self.videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -315,7 +318,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -331,7 +334,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -347,7 +350,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -426,7 +429,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         beforeBal = float(self.getEOSBalance(self.BOB))
-        profileBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        profileBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         HOST.push_action(
             "claim",
             {
@@ -438,7 +441,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
             permission=(self.BOB, Permission.ACTIVE)
         )
         afterBal = float(self.getEOSBalance(self.BOB))
-        profileAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        profileAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         self.assertAlmostEqual(afterBal - beforeBal, 4.011)
         self.assertAlmostEqual(profileBeforeBal - profileAfterBal, 4.011)
 
@@ -525,6 +528,41 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 permission=(self.ALICE, Permission.ACTIVE)
             )
 
+    def test_claim_rejects_non_positive_amounts_and_leaves_winnings_unchanged(self):
+        SCENARIO("test_claim_rejects_non_positive_amounts_and_leaves_winnings_unchanged")
+        profileBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
+
+        for amount in ["-1.0000 EOS", "0.0000 EOS", "1.0000 SYS"]:
+            with self.assertRaises(Error):
+                HOST.push_action(
+                    "claim",
+                    {
+                        "profileId": self.userId2,
+                        "amount": amount,
+                        "to": str(self.BOB),
+                        "memo": "test",
+                    },
+                    force_unique=True,
+                    permission=(self.BOB, Permission.ACTIVE)
+                )
+
+            with self.assertRaises(Error):
+                HOST.push_action(
+                    "claimusd",
+                    {
+                        "profileId": self.userId2,
+                        "claimId": self.randomEOSIOId(),
+                        "amount": amount,
+                    },
+                    force_unique=True,
+                    permission=(self.BOB, Permission.ACTIVE)
+                )
+
+        profileAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
+        self.assertEqual(profileAfterBal, profileBeforeBal)
+        openclaims = HOST.table("openclaims", HOST).json["rows"]
+        self.assertEqual([row for row in openclaims if row["profileId"] == self.userId2], [])
+
     def test_claimusd_sends_funds_and_reduces_profile_winnings_and_creates_openclaim(self):
         SCENARIO("test_claimusd_sends_funds_and_reduces_profile_winnings_and_creates_openclaim")
         TOKENHOST.push_action(
@@ -597,7 +635,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         destBeforeBal = float(self.getEOSBalance(self.CLAIMACCT))
-        profileBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        profileBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
         claimId = self.randomEOSIOId()
         HOST.push_action(
@@ -610,7 +648,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
             permission=(self.BOB, Permission.ACTIVE)
         )
         destAfterBal = float(self.getEOSBalance(self.CLAIMACCT))
-        profileAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        profileAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         self.assertAlmostEqual(destAfterBal - destBeforeBal, 4.011)
         self.assertAlmostEqual(profileBeforeBal - profileAfterBal, 4.011)
 
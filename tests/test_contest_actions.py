@@ -207,6 +207,10 @@ class ContestActionsUnitTest(unittest.TestCase):
             force_unique=1
         )
 
+    def randomVideoHash(self):
+        # entercontest rejects a video already entered, so every entry needs its own
+        return "%064x" % random.getrandbits(256)
+
     def randomEOSIOId(self):
         allowChar = "abcdefghijklmnopqrstuvwxyz12345."
         
@@ -314,7 +318,7 @@ class ContestActionsUnitTest(unittest.TestCase):
     
     def test_enter_contest_saves_fields_into_table(self):
         id = "contestentry"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        videoHash720p = self.randomVideoHash()
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -331,7 +335,12 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        tableRes = HOST.table("entries", HOST, lower=id, key_type="name", limit=1)
+        # stored under the level's category, with the category recorded for lookups by entry id
+        self.assertEqual(len(HOST.table("entries", HOST, lower=id, upper=id, key_type="name").json["rows"]), 0)
+        entryScope = HOST.table("entryscopes", HOST, lower=id, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(entryScope, {"id": id, "categoryId": "music"})
+
+        tableRes = HOST.table("entries", "music", lower=id, key_type="name", limit=1)
 
         entry = tableRes.json["rows"][0]
         now = int(time.time())
@@ -352,6 +361,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             "block": 0,
             "prizeGiven": "0 ",
             "prizeRevoked": 0,
+            "schemaVersion": 1,
         })
 
     def test_enter_contest_requires_auth_of_user(self):
@@ -359,7 +369,6 @@ class ContestActionsUnitTest(unittest.TestCase):
             id = "contestentry2"
             videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-            videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -371,7 +380,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                     "levelId": self.levelId,
                     "videoHash360p": videoHash360p,
                     "videoHash480p": videoHash480p,
-                    "videoHash720p": videoHash720p,
+                    "videoHash720p": self.randomVideoHash(),
                     "videoHash1080p": videoHash1080p,
                     "coverHash": coverHash,
                 }],
@@ -381,7 +390,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_enter_contest_requires_user_to_be_active(self):
         with self.assertRaises(Error):
             id = "contestentry2"
-            videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -391,7 +399,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                     "userId": self.userId5,
                     "id":id,
                     "levelId": self.levelId,
-                    "videoHash720p": videoHash720p,
+                    "videoHash720p": self.randomVideoHash(),
                     "videoHash1080p": videoHash1080p,
                     "coverHash": coverHash,
                 }],
@@ -435,7 +443,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        tableRes = HOST.table("entries", HOST, lower="contestentry4", key_type="name")
+        tableRes = HOST.table("entries", "music", lower="contestentry4", key_type="name")
 
         entry1 = tableRes.json["rows"][0]
         entry2 = tableRes.json["rows"][1]
@@ -458,6 +466,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             "block": 0,
             "prizeGiven": "0 ",
             "prizeRevoked": 0,
+            "schemaVersion": 1,
         })
 
         self.assertGreaterEqual(entry2["createdAt"], now - 1)
@@ -478,12 +487,12 @@ class ContestActionsUnitTest(unittest.TestCase):
             "block": 0,
             "prizeGiven": "0 ",
             "prizeRevoked": 0,
+            "schemaVersion": 1,
         })
 
     def test_entry_payment_activates_entry_in_contest(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -497,7 +506,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -516,14 +525,14 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
         contestId1 = contestId = entry["contestId"]
         self.assertNotEqual(contestId, 0)
 
-        contestsRes = HOST.table("contests", HOST, lower=str(contestId))
+        contestsRes = HOST.table("contests", "music", lower=str(contestId))
         contestData = contestsRes.json["rows"][0]
         self.assertEqual(contestData["id"], contestId)
         self.assertEqual(contestData["levelId"], self.levelId)
@@ -547,7 +556,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -566,14 +575,14 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(BOB, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
         contestId = entry["contestId"]
         self.assertEqual(contestId1, contestId)
 
-        contestsRes = HOST.table("contests", HOST, lower=str(contestId))
+        contestsRes = HOST.table("contests", "music", lower=str(contestId))
         contestData = contestsRes.json["rows"][0]
         self.assertEqual(contestData["id"], contestId)
         self.assertEqual(contestData["levelId"], self.levelId)
@@ -597,7 +606,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -616,7 +625,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(CAROL, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
@@ -624,7 +633,7 @@ class ContestActionsUnitTest(unittest.TestCase):
         self.assertNotEqual(contestId, contestId1)
         self.assertNotEqual(contestId, 0)
 
-        contestsRes = HOST.table("contests", HOST, lower=str(contestId))
+        contestsRes = HOST.table("contests", "music", lower=str(contestId))
         contestData = contestsRes.json["rows"][0]
         self.assertEqual(contestData["id"], contestId)
         self.assertEqual(contestData["levelId"], self.levelId)
@@ -661,7 +670,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -680,7 +689,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(DAN, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
@@ -688,7 +697,7 @@ class ContestActionsUnitTest(unittest.TestCase):
         self.assertNotEqual(contestId, contestId2)
         self.assertNotEqual(contestId, 0)
 
-        contestsRes = HOST.table("contests", HOST, lower=str(contestId))
+        contestsRes = HOST.table("contests", "music", lower=str(contestId))
         contestData = contestsRes.json["rows"][0]
         self.assertEqual(contestData["id"], contestId)
         self.assertEqual(contestData["levelId"], self.levelId)
@@ -715,14 +724,14 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(DAN, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 40000)
         contestId = entry["contestId"]
         self.assertEqual(contestId, contestId3)
 
-        contestsRes = HOST.table("contests", HOST, lower=str(contestId))
+        contestsRes = HOST.table("contests", "music", lower=str(contestId))
         contestData = contestsRes.json["rows"][0]
         self.assertEqual(contestData["id"], contestId)
         self.assertEqual(contestData["levelId"], self.levelId)
@@ -738,7 +747,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_entry_payment_two_levels_doesnt_mark_submissionsClosed(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -759,7 +767,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": firstLevel,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -778,7 +786,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         contestId1 = entry["contestId"]
         
@@ -791,7 +799,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": secondLevel,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -810,22 +818,176 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(BOB, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         contestId2 = entry["contestId"]
 
-        contestsRes1 = HOST.table("contests", HOST, lower=str(contestId1))
+        contestsRes1 = HOST.table("contests", "music", lower=str(contestId1))
         contestData1 = contestsRes1.json["rows"][0]
 
-        contestsRes2 = HOST.table("contests", HOST, lower=str(contestId2))
+        contestsRes2 = HOST.table("contests", "music", lower=str(contestId2))
         contestData2 = contestsRes2.json["rows"][0]
         self.assertEqual(contestData1["submissionsClosed"], 0)
         self.assertEqual(contestData2["submissionsClosed"], 0)
 
+    def test_entry_payment_multi_entry_memo_activates_each_entry(self):
+        videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+
+        id1 = self.randomEOSIOId()
+        id2 = self.randomEOSIOId()
+        for (id, userId, ACCT, levelId) in [(id1, self.userId, ALICE, self.levelId), (id2, self.userId2, BOB, self.levelId2)]:
+            HOST.push_action(
+                "entercontest",
+                [{
+                    "id":id,
+                    "userId": userId,
+                    "levelId": levelId,
+                    "videoHash360p": videoHash360p,
+                    "videoHash480p": videoHash480p,
+                    "videoHash720p": self.randomVideoHash(),
+                    "videoHash1080p": videoHash1080p,
+                    "coverHash": coverHash,
+                }],
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        # amounts must add up to the transfer
+        with self.assertRaises(Error):
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ALICE,
+                    "to": HOST,
+                    "quantity": "4.0000 EOS", 
+                    "memo": "entries:" + id1 + "=2.0000," + id2 + "=1.5",
+                },
+                force_unique=True,
+                permission=(ALICE, Permission.ACTIVE)
+            )
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": HOST,
+                "quantity": "4.5000 EOS", 
+                "memo": "entries:" + id1 + "=2.0000," + id2 + "=2.5",
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        entry1 = HOST.table("entries", "music", lower=id1, key_type="name", limit=1).json["rows"][0]
+        entry2 = HOST.table("entries", "music", lower=id2, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(entry1["amount"], 20000)
+        self.assertEqual(entry2["amount"], 25000)
+        self.assertNotEqual(entry1["contestId"], 0)
+        self.assertNotEqual(entry2["contestId"], 0)
+
+    def test_enter_contest_and_payment_report_entry_status(self):
+        id = self.randomEOSIOId()
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id,
+                "userId": self.userId,
+                "levelId": self.levelId,
+                "videoHash720p": self.randomVideoHash(),
+                "videoHash1080p": "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "coverHash": "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+            }],
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        # $10.00 entry at a $5.0000 high
+        status = HOST.action.json["processed"]["action_traces"][0]["return_value_data"]
+        self.assertEqual(status["entryId"], id)
+        self.assertEqual(status["status"], "unpaid")
+        self.assertEqual(status["amountOwed"], 20000)
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": HOST,
+                "quantity": "1.0000 EOS", 
+                "memo": id,
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        def logged_statuses(traces):
+            statuses = []
+            for trace in traces:
+                if trace["act"]["name"] == "logentry":
+                    statuses.append(trace["act"]["data"]["result"])
+                statuses += logged_statuses(trace.get("inline_traces", []))
+            return statuses
+
+        statuses = logged_statuses(TOKENHOST.action.json["processed"]["action_traces"])
+        self.assertEqual(statuses[0]["status"], "underpaid")
+        self.assertEqual(statuses[0]["amountOwed"], 10000)
+
+    def test_entry_payment_emits_lifecycle_events_to_listener(self):
+        def traced_actions(traces):
+            names = []
+            for trace in traces:
+                names.append((trace["act"]["name"], trace["receiver"]))
+                names += traced_actions(trace.get("inline_traces", []))
+            return names
+
+        HOST.push_action(
+            "setlistener",
+            [CAROL],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        id = self.randomEOSIOId()
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id,
+                "userId": self.userId,
+                "levelId": self.levelId,
+                "videoHash720p": self.randomVideoHash(),
+                "videoHash1080p": "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "coverHash": "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+            }],
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": HOST,
+                "quantity": "2.0000 EOS", 
+                "memo": id,
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+        actions = traced_actions(TOKENHOST.action.json["processed"]["action_traces"])
+
+        HOST.push_action(
+            "setlistener",
+            [""],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        self.assertIn(("evcreated", str(CAROL)), actions)
+        self.assertIn(("evactivate", str(CAROL)), actions)
+        self.assertIn(("evvotestart", str(CAROL)), actions)
+
     def test_entry_payment_doesnt_activate_when_entry_expired(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -846,7 +1008,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -867,7 +1029,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
@@ -877,7 +1039,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_entry_payment_doesnt_activate_when_payment_not_enough(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -898,7 +1059,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -917,7 +1078,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 10000)
@@ -927,7 +1088,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_entry_payment_doesnt_activate_when_price_not_fresh(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -955,7 +1115,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -976,7 +1136,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["priceUnavailable"], 1)
@@ -987,7 +1147,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_enter_contest_limits_to_one_active_within_level(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1000,7 +1159,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1031,17 +1190,78 @@ class ContestActionsUnitTest(unittest.TestCase):
                     "levelId": self.levelId,
                     "videoHash360p": videoHash360p,
                     "videoHash480p": videoHash480p,
-                    "videoHash720p": videoHash720p,
+                    "videoHash720p": self.randomVideoHash(),
                     "videoHash1080p": videoHash1080p,
                     "coverHash": coverHash,
                 }],
                 permission=(ALICE, Permission.ACTIVE)
             )
     
+    def test_enter_contest_rejects_video_already_entered(self):
+        def logged_statuses(traces):
+            statuses = []
+            for trace in traces:
+                if trace["act"]["name"] == "logentry":
+                    statuses.append(trace["act"]["data"]["result"])
+                statuses += logged_statuses(trace.get("inline_traces", []))
+            return statuses
+
+        def enter(id, userId, ACCT, videoHash1080p):
+            HOST.push_action(
+                "entercontest",
+                [{
+                    "id": id,
+                    "userId": userId,
+                    "levelId": self.levelId,
+                    "videoHash720p": videoHash720p,
+                    "videoHash1080p": videoHash1080p,
+                    "coverHash": coverHash,
+                }],
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        def pay(id, ACCT):
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ACCT,
+                    "to": HOST,
+                    "quantity": "2.0000 EOS",
+                    "memo": id,
+                },
+                force_unique=True,
+                permission=(ACCT, Permission.ACTIVE)
+            )
+            return logged_statuses(TOKENHOST.action.json["processed"]["action_traces"])[0]
+
+        videoHash720p = self.randomVideoHash()
+        videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        aliceEntry = self.randomEOSIOId()
+        bobEntry = self.randomEOSIOId()
+
+        # an unpaid entry doesn't hold the video
+        enter(aliceEntry, self.userId, ALICE, videoHash1080p)
+        enter(bobEntry, self.userId2, BOB, videoHash1080p)
+
+        # the first entry paid takes it, the other one is paid too late & stays out of the contest
+        self.assertEqual(pay(aliceEntry, ALICE)["status"], "active")
+        status = pay(bobEntry, BOB)
+        self.assertEqual(status["status"], "duplicate")
+        self.assertEqual(status["contestId"], 0)
+        entry = HOST.table("entries", "music", lower=bobEntry, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(entry["contestId"], 0)
+        self.assertEqual(entry["amount"], 20000)
+
+        with self.assertRaises(Error):
+            enter(self.randomEOSIOId(), self.userId3, CAROL, videoHash1080p)
+
+        # same 720p hash with another 1080p hash is a different video
+        enter(self.randomEOSIOId(), self.userId3, CAROL, self.randomVideoHash())
+
     def test_entercontest_verify_success_when_has_past_submissions_within_level(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1054,7 +1274,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1095,7 +1315,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1114,7 +1334,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 20000)
@@ -1124,7 +1344,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_refund_entry_payment_sends_funds(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1137,7 +1356,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1169,7 +1388,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["amount"], 0)
@@ -1177,10 +1396,104 @@ class ContestActionsUnitTest(unittest.TestCase):
         accountsRes = TOKENHOST.table("accounts", ALICE)
         self.assertEqual(accountsRes.json["rows"][0]["balance"], beforeBal)
 
+    def test_sweep_refunds_returns_expired_entry_funds(self):
+        videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+
+        # an account of its own, no payment left over by other tests is swept back to it
+        create_account("FRANK", MASTER)
+        TOKENHOST.push_action(
+            "issue",
+            {
+                "to": FRANK, "quantity": "100.0000 EOS", "memo": ""
+            },
+            force_unique=True,
+            permission=(MASTER, Permission.ACTIVE)
+        )
+
+        userId = self.randomEOSIOId()
+        HOST.push_action(
+            "addprofile",
+            [{
+                "id":userId,
+                "username":userId,
+                "imgHash":"950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account": FRANK,
+                "active": True,
+                "link": "",
+                "bio": "",
+            }],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        id = self.randomEOSIOId()
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id,
+                "userId": userId,
+                "levelId": self.levelId,
+                "videoHash720p": self.randomVideoHash(),
+                "videoHash1080p": videoHash1080p,
+                "coverHash": coverHash,
+            }],
+            permission=(FRANK, Permission.ACTIVE)
+        )
+
+        # entryexp is 2 seconds, the payment arrives too late to activate
+        time.sleep(3)
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": FRANK,
+                "to": HOST,
+                "quantity": "2.0000 EOS",
+                "memo": id,
+            },
+            force_unique=True,
+            permission=(FRANK, Permission.ACTIVE)
+        )
+
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name", limit=1)
+        self.assertEqual(entriesRes.json["rows"][0]["id"], id)
+        self.assertEqual(entriesRes.json["rows"][0]["contestId"], 0)
+        self.assertEqual(entriesRes.json["rows"][0]["amount"], 20000)
+        self.assertEqual(TOKENHOST.table("accounts", FRANK).json["rows"][0]["balance"], "98.0000 EOS")
+
+        HOST.push_action("sweeprefunds", force_unique=True, permission=(HOST, Permission.ACTIVE))
+
+        # the whole payment comes back & the entry is erased with its scope row
+        self.assertEqual(TOKENHOST.table("accounts", FRANK).json["rows"][0]["balance"], "100.0000 EOS")
+
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name", limit=1)
+        self.assertTrue(len(entriesRes.json["rows"]) == 0 or entriesRes.json["rows"][0]["id"] != id)
+
+        entryscopesRes = HOST.table("entryscopes", HOST, lower=id, key_type="name", limit=1)
+        self.assertTrue(len(entryscopesRes.json["rows"]) == 0 or entryscopesRes.json["rows"][0]["id"] != id)
+
+    def test_migrate_walks_versioned_tables(self):
+        # rows written by this build are already current, so a pass only scans
+        for table in ["entries", "contests", "profiles", "levels"]:
+            HOST.push_action("migrate", {"table": table}, force_unique=True, permission=(HOST, Permission.ACTIVE))
+            self.assertEqual(HOST.action.json["processed"]["action_traces"][0]["return_value_data"], True)
+
+        # plain text profiles carry a zeroed text ahead of schemaVersion
+        profile = HOST.table("profiles", HOST, lower=self.userId, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(profile["text"], {
+            "linkHash": "0" * 64,
+            "linkLength": 0,
+            "bioHash": "0" * 64,
+            "bioLength": 0,
+        })
+        self.assertEqual(profile["schemaVersion"], 1)
+
+        with self.assertRaises(Error):
+            HOST.push_action("migrate", {"table": "votes"}, force_unique=True, permission=(HOST, Permission.ACTIVE))
+
     def test_refund_entry_payment_fails_when_contest_is_set(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1193,7 +1506,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1226,7 +1539,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_refund_entry_payment_requires_user_auth(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1239,7 +1551,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1272,7 +1584,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_vote_saves_to_votes_table_and_updates_entry_votes_count(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1285,7 +1596,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1313,7 +1624,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1344,13 +1655,13 @@ class ContestActionsUnitTest(unittest.TestCase):
         )
 
         # increments entries vote count
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         self.assertEqual(entry["votes"], 1)
 
         # saves vote into table
-        votesRes = HOST.table("votes", HOST)
+        votesRes = HOST.table("votes", "music")
         vote = False
         for voteRow in votesRes.json["rows"]:
             if (
@@ -1369,7 +1680,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_vote_requires_user_auth(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1382,7 +1692,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1410,7 +1720,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1444,7 +1754,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_vote_fails_when_account_is_not_active(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1457,7 +1766,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1485,7 +1794,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1519,7 +1828,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_vote_fails_when_already_voted_in_contest(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1532,7 +1840,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1560,7 +1868,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1600,10 +1908,93 @@ class ContestActionsUnitTest(unittest.TestCase):
                 permission=(CAROL, Permission.ACTIVE)
             )
 
+    def test_votebatch_is_atomic_and_limits_one_vote_per_contest(self):
+        videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+        coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
+
+        id = "myentry113"
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id,
+                "userId": self.userId,
+                "levelId": self.levelId,
+                "videoHash720p": self.randomVideoHash(),
+                "videoHash1080p": videoHash1080p,
+                "coverHash": coverHash,
+            }],
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": HOST,
+                "quantity": "2.0000 EOS",
+                "memo": id,
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        id2 = "myentry113b"
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id2,
+                "userId": self.userId2,
+                "levelId": self.levelId,
+                "videoHash720p": self.randomVideoHash(),
+                "videoHash1080p": videoHash1080p,
+                "coverHash": coverHash,
+            }],
+            permission=(BOB, Permission.ACTIVE)
+        )
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": BOB,
+                "to": HOST,
+                "quantity": "2.0000 EOS",
+                "memo": id2,
+            },
+            force_unique=True,
+            permission=(BOB, Permission.ACTIVE)
+        )
+
+        time.sleep(3) # 2 seconds is the time of the submission period
+
+        # both entries are in the same contest
+        with self.assertRaises(Error):
+            HOST.push_action(
+                "votebatch",
+                {
+                    "voterUserId": self.userId3,
+                    "entryIds": [id, id2],
+                },
+                permission=(CAROL, Permission.ACTIVE)
+            )
+
+        entry = HOST.table("entries", "music", lower=id, key_type="name").json["rows"][0]
+        self.assertEqual(entry["votes"], 0)
+
+        HOST.push_action(
+            "votebatch",
+            {
+                "voterUserId": self.userId3,
+                "entryIds": [id2],
+            },
+            permission=(CAROL, Permission.ACTIVE)
+        )
+
+        entry = HOST.table("entries", "music", lower=id2, key_type="name").json["rows"][0]
+        self.assertEqual(entry["votes"], 1)
+
     def test_vote_fails_when_contest_voting_period_hasnt_started(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1616,7 +2007,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1644,7 +2035,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1676,7 +2067,6 @@ class ContestActionsUnitTest(unittest.TestCase):
     def test_vote_fails_when_contest_voting_period_has_ended(self):
         videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1689,7 +2079,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1717,7 +2107,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": videoHash360p,
                 "videoHash480p": videoHash480p,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1762,7 +2152,6 @@ class ContestActionsUnitTest(unittest.TestCase):
         )
 
         with self.assertRaises(Error):
-            videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
             coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1773,7 +2162,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                     "id":id,
                     "userId": self.userId,
                     "levelId": self.levelId3,
-                    "videoHash720p": videoHash720p,
+                    "videoHash720p": self.randomVideoHash(),
                     "videoHash1080p": videoHash1080p,
                     "coverHash": coverHash,
                 }],
@@ -1792,8 +2181,6 @@ class ContestActionsUnitTest(unittest.TestCase):
             force_unique=True,
             permission=(ALICE, Permission.ACTIVE)
         )
-
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1804,14 +2191,12 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "id":id,
                 "userId": self.userId,
                 "levelId": self.levelId3,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
             permission=(ALICE, Permission.ACTIVE)
         )
-
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1822,7 +2207,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "id":id,
                 "userId": self.userId2,
                 "levelId": self.levelId3,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1830,7 +2215,6 @@ class ContestActionsUnitTest(unittest.TestCase):
         )
 
     def test_new_contest_using_voteStartUTCHour_has_proper_starttime(self):
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1841,7 +2225,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "id":id,
                 "userId": self.userId,
                 "levelId": self.levelId2,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1860,7 +2244,7 @@ class ContestActionsUnitTest(unittest.TestCase):
             permission=(ALICE, Permission.ACTIVE)
         )
 
-        entriesRes = HOST.table("entries", HOST, lower=id, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=id, key_type="name")
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], id)
         contestId1 = contestId = entry["contestId"]
@@ -1877,7 +2261,6 @@ class ContestActionsUnitTest(unittest.TestCase):
         )
     
     def test_allowedSimultaneousContests(self):
-        videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -1888,7 +2271,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "id":id,
                 "userId": self.userId,
                 "levelId": self.levelId2,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1914,7 +2297,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                 "id":id,
                 "userId": self.userId2,
                 "levelId": self.levelId2,
-                "videoHash720p": videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": videoHash1080p,
                 "coverHash": coverHash,
             }],
@@ -1941,7 +2324,7 @@ class ContestActionsUnitTest(unittest.TestCase):
                     "id":id,
                     "userId": self.userId3,
                     "levelId": self.levelId2,
-                    "videoHash720p": videoHash720p,
+                    "videoHash720p": self.randomVideoHash(),
                     "videoHash1080p": videoHash1080p,
                     "coverHash": coverHash,
                 }],
@@ -76,6 +76,46 @@ class LevelActionsUnitTest(unittest.TestCase):
             "prizes": [70, 20, 10],
         }])
             
+    def test_create_level_saves_level_rule(self):
+        HOST.push_action(
+            "createlevel", 
+            [{
+                "id":"silver",
+                "name":"Silver",
+                "categoryId": "music",
+                "price": 1000,
+                "participantLimit": 100,
+                "submissionPeriod": 12,
+                "votePeriod": 12,
+                "fee": 15, # = 1.5%
+                "prizes": [70, 20, 10],
+                "fixedPrize": 0,
+                "allowedSimultaneousContests": 0,
+                "voteStartUTCHour": 17,
+                "minParticipant": 0,
+            }], 
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        ruleRes = HOST.table("levelrules", HOST, lower="silver", upper="silver")
+
+        # a paid entry pool level sets no flags, the vote hour is kept for its contests, prizes as running totals
+        self.assertEqual(ruleRes.json["rows"], [{
+            "id": "silver",
+            "categoryId": "music",
+            "flags": 0,
+            "voteStartUTCHour": 17,
+            "fee": 15,
+            "price": 1000,
+            "fixedPrize": 0,
+            "participantLimit": 100,
+            "allowedSimultaneousContests": 0,
+            "submissionPeriod": 12,
+            "votePeriod": 12,
+            "minParticipant": 0,
+            "prizeSums": [70, 90, 100],
+        }])
+
     def test_create_level_requires_auth_of_self(self):
         with self.assertRaises(MissingRequiredAuthorityError):
             HOST.push_action(
@@ -114,6 +154,7 @@ class LevelActionsUnitTest(unittest.TestCase):
                     "fixedPrize": 0,
                     "allowedSimultaneousContests": 0,
                     "voteStartUTCHour": 0,
+                    "minParticipant": 0,
                 }], 
                 permission=(HOST, Permission.ACTIVE)
             )
@@ -0,0 +1,304 @@
+import unittest, sys, json, time
+from eosfactory.eosf import *
+
+verbosity([Verbosity.INFO, Verbosity.OUT, Verbosity.TRACE, Verbosity.DEBUG, Verbosity.ERROR])
+
+CONTRACT_WORKSPACE = sys.path[0] + "/../"
+PAYMENTS_CONTRACT_WORKSPACE = sys.path[0] + "/../payments"
+TOKEN_CONTRACT_WORKSPACE = "_iqhgcqllgnpkirjwwkms"
+
+# Actors of the test:
+MASTER = MasterAccount()
+HOST = Account()
+PAYHOST = Account()
+TOKENHOST = Account()
+ALICE = Account()
+
+class PaymentsUnitTest(unittest.TestCase):
+
+    def run(self, result=None):
+        super().run(result)
+
+    @classmethod
+    def setUpClass(cls):
+        reset()
+        create_master_account("MASTER")
+
+        create_account("TOKENHOST", MASTER, account_name='eosio.token')
+        tokSmart = Contract(TOKENHOST, project_from_template(TOKEN_CONTRACT_WORKSPACE, template="eosio_token", remove_existing=True))
+        tokSmart.build()
+        tokSmart.deploy()
+
+        create_account("HOST", MASTER)
+        smart = Contract(HOST, CONTRACT_WORKSPACE)
+        smart.build()
+        smart.deploy()
+
+        create_account("PAYHOST", MASTER)
+        paySmart = Contract(PAYHOST, PAYMENTS_CONTRACT_WORKSPACE)
+        paySmart.build()
+        paySmart.deploy()
+
+        # set eosio.code permission to both contracts
+        HOST.set_account_permission(
+            permission_name=Permission.ACTIVE,
+            add_code=True,
+            permission=(HOST, Permission.OWNER)
+        )
+
+        PAYHOST.set_account_permission(
+            permission_name=Permission.ACTIVE,
+            add_code=True,
+            permission=(PAYHOST, Permission.OWNER)
+        )
+
+        create_account("ALICE", MASTER)
+
+        # create EOS tokens
+        TOKENHOST.push_action(
+            "create",
+            {
+                "issuer": MASTER,
+                "maximum_supply": "1000000000.0000 EOS",
+                "can_freeze": "0",
+                "can_recall": "0",
+                "can_whitelist": "0"
+            },
+            force_unique=True,
+            permission=[(MASTER, Permission.ACTIVE), (TOKENHOST, Permission.ACTIVE)],
+        )
+
+        TOKENHOST.push_action(
+            "issue",
+            {
+                "to": ALICE, "quantity": "100.0000 EOS", "memo": ""
+            },
+            force_unique=True,
+            permission=(MASTER, Permission.ACTIVE)
+        )
+
+        HOST.push_action(
+            "setcurrency",
+            ["EOS"],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        HOST.push_action(
+            "setpayments",
+            [PAYHOST],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        PAYHOST.push_action(
+            "setcontests",
+            [HOST],
+            permission=(PAYHOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        cls.userId = 'username123'
+
+        HOST.push_action(
+            "addprofile",
+            [{
+                "id":cls.userId,
+                "username":cls.userId,
+                "imgHash":"950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account": ALICE,
+                "active": True,
+                "link": "",
+                "bio": "",
+            }],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        HOST.push_action(
+            "createcat",
+            {
+                "id":"music",
+                "name":"Music",
+                "maxVideoLength": 30,
+            },
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        cls.levelId = 'gold1'
+
+        HOST.push_action(
+            "createlevel",
+            [{
+                "id":cls.levelId,
+                "name":"Gold",
+                "categoryId": "music",
+                "price": 1000,
+                "participantLimit": 2,
+                "submissionPeriod": 2,
+                "votePeriod": 2,
+                "fee": 0,
+                "prizes": [100],
+                "fixedPrize": 0,
+                "allowedSimultaneousContests": 0,
+                "voteStartUTCHour": 0,
+                "minParticipant": 0,
+            }],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+    def getEOSBalance(self, account):
+        rows = TOKENHOST.table("accounts", account).json["rows"]
+        if len(rows) == 0:
+            return 0.0
+        return float(rows[0]["balance"].split(' ')[0])
+
+    def test_prizefund_payment_is_forwarded_and_held_by_payments(self):
+        payBeforeBal = self.getEOSBalance(PAYHOST)
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": PAYHOST,
+                "quantity": "1.0000 EOS",
+                "memo": "prizefund",
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        options = HOST.table("options", HOST).json["rows"]
+        prizefund = [row["value"] for row in options if row["id"] == "prizefund"]
+        self.assertEqual(prizefund, ["10000"])
+        self.assertAlmostEqual(self.getEOSBalance(PAYHOST) - payBeforeBal, 1.0)
+        self.assertAlmostEqual(self.getEOSBalance(HOST), 0.0)
+
+    def test_payment_in_other_currency_is_not_forwarded(self):
+        # payments reads the currency option of the contest contract, a SYS transfer stays with it
+        TOKENHOST.push_action(
+            "create",
+            {
+                "issuer": MASTER,
+                "maximum_supply": "1000000000.0000 SYS",
+                "can_freeze": "0",
+                "can_recall": "0",
+                "can_whitelist": "0"
+            },
+            force_unique=True,
+            permission=[(MASTER, Permission.ACTIVE), (TOKENHOST, Permission.ACTIVE)],
+        )
+
+        TOKENHOST.push_action(
+            "issue",
+            {
+                "to": ALICE, "quantity": "10.0000 SYS", "memo": ""
+            },
+            force_unique=True,
+            permission=(MASTER, Permission.ACTIVE)
+        )
+
+        prizefundBefore = [row["value"] for row in HOST.table("options", HOST).json["rows"] if row["id"] == "prizefund"]
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": PAYHOST,
+                "quantity": "1.0000 SYS",
+                "memo": "prizefund",
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        def traced_actions(traces):
+            names = []
+            for trace in traces:
+                names.append(trace["act"]["name"])
+                names += traced_actions(trace.get("inline_traces", []))
+            return names
+
+        self.assertNotIn("fund", traced_actions(TOKENHOST.action.json["processed"]["action_traces"]))
+        prizefundAfter = [row["value"] for row in HOST.table("options", HOST).json["rows"] if row["id"] == "prizefund"]
+        self.assertEqual(prizefundAfter, prizefundBefore)
+
+    def test_direct_payment_fails_when_payments_contract_set(self):
+        with self.assertRaises(Error):
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ALICE,
+                    "to": HOST,
+                    "quantity": "1.0000 EOS",
+                    "memo": "prizefund",
+                },
+                force_unique=True,
+                permission=(ALICE, Permission.ACTIVE)
+            )
+
+    def test_fund_requires_payments_auth(self):
+        with self.assertRaises(MissingRequiredAuthorityError):
+            HOST.push_action(
+                "fund",
+                {
+                    "from": ALICE,
+                    "quantity": "1.0000 EOS",
+                    "memo": "prizefund",
+                },
+                force_unique=True,
+                permission=(ALICE, Permission.ACTIVE)
+            )
+
+    def test_refund_is_paid_out_by_payments(self):
+        id = "myentry1"
+        HOST.push_action(
+            "entercontest",
+            [{
+                "id":id,
+                "userId": self.userId,
+                "levelId": self.levelId,
+                "videoHash720p": "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "videoHash1080p": "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "coverHash": "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+            }],
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        aliceBeforeBal = self.getEOSBalance(ALICE)
+
+        TOKENHOST.push_action(
+            "transfer",
+            {
+                "from": ALICE,
+                "to": PAYHOST,
+                "quantity": "1.0000 EOS",
+                "memo": id,
+            },
+            force_unique=True,
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        entry = HOST.table("entries", "music", lower=id, key_type="name").json["rows"][0]
+        self.assertEqual(entry["amount"], 10000)
+
+        HOST.push_action(
+            "refundentry",
+            {
+                "id":id,
+                "to": ALICE,
+                "memo": "test",
+            },
+            permission=(ALICE, Permission.ACTIVE)
+        )
+
+        entry = HOST.table("entries", "music", lower=id, key_type="name").json["rows"][0]
+        self.assertEqual(entry["amount"], 0)
+        self.assertAlmostEqual(self.getEOSBalance(ALICE), aliceBeforeBal)
+
+    @classmethod
+    def tearDownClass(cls):
+        stop()
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -1,4 +1,4 @@
-import unittest, sys, json, hashlib
+import unittest, sys, json, hashlib, random
 from eosfactory.eosf import *
 import eosfactory.core.setup as setup
 
@@ -30,8 +30,26 @@ class ProfileActionsUnitTest(unittest.TestCase):
         create_account("ALICE", MASTER)
         create_account("BOB", MASTER)
 
+    def randomPythonVar(self):
+        allowChar = "abcdefghijklmnopqrstuvwxyz12345"
+        
+        randomId = ""
+        for i in range(0, 11):
+            randomCharIndex = random.randrange(0,31,1)
+            randomId += allowChar[randomCharIndex]
+        
+        return randomId
+
+    def createRandomGlobalUser(self, prefix = ""):
+        uservar = prefix + self.randomPythonVar()
+        create_account(uservar, MASTER)
+        return globals()[uservar]
+
     def setUp(self):
-        pass
+        # one profile per account, so every test gets fresh accounts
+        global ALICE, BOB
+        ALICE = self.createRandomGlobalUser("user_alice_")
+        BOB = self.createRandomGlobalUser("user_bob_")
 
     def test_create_profile_saves_fields_into_table(self):
         SCENARIO('''
@@ -81,6 +99,52 @@ class ProfileActionsUnitTest(unittest.TestCase):
             "bio": "I am a test user. &lt;script&gt;alert(&apos;xss&apos;)&lt;/script&gt;",
         }])
 
+    def test_create_profile_in_hash_text_mode_stores_only_hashes(self):
+        SCENARIO('''
+        test_create_profile_in_hash_text_mode_stores_only_hashes
+        ''')
+
+        HOST.push_action(
+            "settextmode",
+            ["hash"],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        id = "31a55254b3523"
+        username = "cryptocat789"
+        link = "https://google.com/a/very/long/link"
+        bio = "I am a test user. <b>bold</b>"
+
+        HOST.push_action(
+            "addprofile",
+            [{
+                "id":id,
+                "username":username,
+                "imgHash":"950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account": ALICE,
+                "active": True,
+                "link": link,
+                "bio": bio,
+            }],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        HOST.push_action(
+            "settextmode",
+            ["plain"],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        row = HOST.table("profiles", HOST, lower=id, key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(row["link"], "")
+        self.assertEqual(row["bio"], "")
+        self.assertEqual(row["text"]["linkHash"], hashlib.sha256(link.encode()).hexdigest())
+        self.assertEqual(row["text"]["linkLength"], len(link))
+        self.assertEqual(row["text"]["bioHash"], hashlib.sha256(bio.encode()).hexdigest())
+        self.assertEqual(row["text"]["bioLength"], len(bio))
+
     def test_create_profile_requires_auth_of_self(self):
         pass
         SCENARIO('''
@@ -202,6 +266,62 @@ class ProfileActionsUnitTest(unittest.TestCase):
                 permission=(HOST, Permission.ACTIVE)
             )
 
+    def test_add_profiles_imports_batch_and_rejects_lookalikes(self):
+        SCENARIO('''
+        test_add_profiles_imports_batch_and_rejects_lookalikes
+        ''')
+
+        def profileArgs(id, username, account):
+            return {
+                "id":id,
+                "username":username,
+                "imgHash":"950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account":account,
+                "active":True,
+                "link": "https://google.com",
+                "bio": "I am a test user.",
+            }
+
+        HOST.push_action(
+            "addprofiles",
+            [[
+                profileArgs("2222222222221", "bulkimport1", ALICE),
+                profileArgs("2222222222222", "bulkimport2", BOB),
+            ]],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        table = HOST.table("profiles", HOST, lower="2222222222221", upper="2222222222222", key_type="name")
+        self.assertEqual([row["username"] for row in table.json["rows"]], ["bulkimport1", "bulkimport2"])
+
+        auth = HOST.table("profauths", HOST, lower="2222222222222", key_type="name", limit=1).json["rows"][0]
+        self.assertEqual(auth["account"], str(BOB))
+
+        # look-alikes within the batch
+        with self.assertRaises(Error):
+            HOST.push_action(
+                "addprofiles",
+                [[
+                    profileArgs("2222222222223", "bulkcheck01", ALICE),
+                    profileArgs("2222222222224", "buIkcheck01", BOB),
+                ]],
+                permission=(HOST, Permission.ACTIVE)
+            )
+
+        # look-alike of an existing profile fails the whole batch
+        with self.assertRaises(Error):
+            HOST.push_action(
+                "addprofiles",
+                [[
+                    profileArgs("2222222222223", "bulkcheck02", ALICE),
+                    profileArgs("2222222222224", "BulkImport1", BOB),
+                ]],
+                permission=(HOST, Permission.ACTIVE)
+            )
+
+        table = HOST.table("profiles", HOST, lower="2222222222223", upper="2222222222224", key_type="name")
+        self.assertEqual(len(table.json["rows"]), 0)
+
     def test_create_profile_ensures_valid_username(self):
         pass
         SCENARIO('''
@@ -375,6 +495,64 @@ class ProfileActionsUnitTest(unittest.TestCase):
                 "bio": "I am a test user.",
             }])
 
+    def test_profile_lookup_by_account(self):
+        SCENARIO('''
+        test_profile_lookup_by_account
+        ''')
+
+        def profileArgs(id, username, account):
+            return {
+                "id":id,
+                "username":username,
+                "imgHash":"950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                "account":account,
+                "active":True,
+                "link": "",
+                "bio": "",
+            }
+
+        CAROL = self.createRandomGlobalUser("user_carol_")
+
+        HOST.push_action("addprofile", [profileArgs("3333333333331", "acctlookup1", ALICE)], permission=(HOST, Permission.ACTIVE))
+        HOST.push_action("addprofile", [profileArgs("3333333333332", "acctlookup2", BOB)], permission=(HOST, Permission.ACTIVE))
+
+        HOST.push_action("profbyacct", {"account": ALICE}, permission=(HOST, Permission.ACTIVE), force_unique=1)
+        lookup = HOST.action.json["processed"]["action_traces"][0]["return_value_data"]
+        self.assertEqual(lookup["id"], "3333333333331")
+        self.assertEqual(lookup["username"], "acctlookup1")
+        self.assertEqual(lookup["account"], str(ALICE))
+
+        # one profile per account
+        with self.assertRaises(Error):
+            HOST.push_action("addprofile", [profileArgs("3333333333333", "acctlookup3", ALICE)], permission=(HOST, Permission.ACTIVE))
+
+        with self.assertRaises(Error):
+            HOST.push_action(
+                "addprofiles",
+                [[profileArgs("3333333333333", "acctlookup3", CAROL), profileArgs("3333333333334", "acctlookup4", CAROL)]],
+                permission=(HOST, Permission.ACTIVE)
+            )
+
+        with self.assertRaises(Error):
+            HOST.push_action(
+                "editprofadm",
+                {
+                    "id": "3333333333332",
+                    "data": {
+                        "username": "acctlookup2",
+                        "imgHash": "950fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9",
+                        "account": ALICE,
+                        "link": "",
+                        "bio": "",
+                        "active": True,
+                    }
+                },
+                permission=(HOST, Permission.ACTIVE)
+            )
+
+        with self.assertRaises(Error):
+            HOST.push_action("profbyacct", {"account": CAROL}, permission=(HOST, Permission.ACTIVE), force_unique=1)
+
     def test_edit_profile_modifies_table_when_user_auth(self):
         SCENARIO('''
         test_edit_profile_modifies_table_when_user_auth
@@ -620,6 +798,14 @@ class ProfileActionsUnitTest(unittest.TestCase):
             "link": "https://google.com/edit",
             "bio": "I am a test edit user.",
         }])
+
+        authRes = HOST.table("profauths", HOST, lower=id, key_type="name", limit=1)
+        self.assertEqual(authRes.json["rows"], [{
+            "id":id,
+            "account": str(BOB),
+            "active": 0,
+            "flags": 0,
+        }])
     
     def test_edit_profile_with_same_username_modifies_table_when_admin_auth(self):
         SCENARIO('''
@@ -236,7 +236,7 @@ class randomDebugUnitTest(unittest.TestCase):
             permission=(BOB, Permission.ACTIVE)
         )
 
-        tableRes = HOST.table("entries", HOST,)
+        tableRes = HOST.table("entries", "music",)
 
 if __name__ == "__main__":
     unittest.main()
@@ -11,6 +11,10 @@ MASTER = MasterAccount()
 HOST = Account()
 TOKENHOST = Account()
 
+# archive budget costs, mirroring the archiveCost* constants in flair.cpp
+ARCHIVE_COST_SCAN = 1
+ARCHIVE_COST_ENTRY = 8
+
 def extract_profile_winnings(rows):
     if (len(rows) == 0):
         return 0
@@ -74,6 +78,10 @@ class UpdateActionsUnitTest(unittest.TestCase):
             force_unique=1
         )
 
+    def randomVideoHash(self):
+        # entercontest rejects a video already entered, so every entry needs its own
+        return "%064x" % random.getrandbits(256)
+
     def randomEOSIOId(self):
         allowChar = "abcdefghijklmnopqrstuvwxyz12345."
         
@@ -292,7 +300,6 @@ class UpdateActionsUnitTest(unittest.TestCase):
 
         self.videoHash360p = "150fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash480p = "250fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
-        self.videoHash720p = "350fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.videoHash1080p = "450fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
         self.coverHash = "550fe755a7ef10e2dfdca952bb877cc023e9a4f3f2d896455e62cb6a442f5bb9"
 
@@ -305,7 +312,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -321,7 +328,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -337,13 +344,261 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
             permission=(self.CAROL, Permission.ACTIVE)
         )
 
+    def test_update_action_aggregates_fee_transfers_of_contests_settled_together(self):
+        SCENARIO("test_update_action_aggregates_fee_transfers_of_contests_settled_together")
+        def fee_transfers(traces):
+            transfers = []
+            for trace in traces:
+                act = trace["act"]
+                if act["name"] == "transfer" and trace["receiver"] == "eosio.token" and act["data"]["to"] == str(self.FEEACCT):
+                    transfers.append(act["data"])
+                transfers += fee_transfers(trace.get("inline_traces", []))
+            return transfers
+
+        # a second level like the first, its contest ends alongside the one from setUp
+        levelId = self.randomEOSIOId()
+        HOST.push_action(
+            "createlevel", 
+            [{
+                "id":levelId,
+                "name":"Silver",
+                "categoryId": "music",
+                "price": 1000,
+                "participantLimit": 4,
+                "submissionPeriod": 4,
+                "votePeriod": 4,
+                "fee": 45, # = 4.5%
+                "prizes": [70, 30],
+                "fixedPrize": 0,
+                "allowedSimultaneousContests": 0,
+                "voteStartUTCHour": 0,
+            }], 
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        entryIdB = self.randomEOSIOId()
+        entryIdB2 = self.randomEOSIOId()
+        for (entryId, userId, ACCT) in [(entryIdB, self.userId, self.ALICE), (entryIdB2, self.userId2, self.BOB)]:
+            HOST.push_action(
+                "entercontest",
+                [{
+                    "id": entryId,
+                    "userId": userId,
+                    "levelId": levelId,
+                    "videoHash720p": self.randomVideoHash(),
+                    "videoHash1080p": self.videoHash1080p,
+                    "coverHash": self.coverHash,
+                }],
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        HOST.push_action(
+            "addcurhigh",
+            {
+                "openTime": int(time.time()),
+                "usdHigh": 50000, # $5.0000
+                "intervalSec": 2, # 2 seconds
+            },
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        payments = [
+            (self.ALICE, self.entryId), (self.BOB, self.entryId2), (self.CAROL, self.entryId3),
+            (self.ALICE, entryIdB), (self.BOB, entryIdB2),
+        ]
+        for (ACCT, entryId) in payments:
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ACCT,
+                    "to": HOST,
+                    "quantity": "2.0000 EOS", 
+                    "memo": entryId,
+                },
+                force_unique=True,
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        time.sleep(5)
+
+        votes = [
+            (self.ALICE, self.userId, self.entryId), (self.BOB, self.userId2, self.entryId2), (self.CAROL, self.userId3, self.entryId2),
+            (self.ALICE, self.userId, entryIdB2), (self.CAROL, self.userId3, entryIdB2), (self.BOB, self.userId2, entryIdB),
+        ]
+        for (ACCT, voterUserId, entryId) in votes:
+            HOST.push_action(
+                "vote",
+                {
+                    "entryId": entryId,
+                    "voterUserId": voterUserId,
+                },
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        time.sleep(4)
+
+        feeBeforeBal = float(self.getEOSBalance(self.FEEACCT))
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+        transfers = fee_transfers(HOST.action.json["processed"]["action_traces"])
+
+        # both contests are settled by this call, their fees of 0.2700 & 0.1800 go out as one transfer
+        contestIds = [
+            HOST.table("entries", "music", lower=entryId, key_type="name").json["rows"][0]["contestId"]
+            for entryId in [self.entryId, entryIdB]
+        ]
+        self.assertNotEqual(contestIds[0], contestIds[1])
+        fees = [HOST.table("results", HOST, lower=contestId).json["rows"][0]["fee"] for contestId in contestIds]
+        self.assertEqual(fees, ["0.2700 EOS", "0.1800 EOS"])
+
+        self.assertEqual(len(transfers), 1)
+        self.assertEqual(transfers[0]["quantity"], "0.4500 EOS")
+        self.assertEqual(transfers[0]["memo"], "my memo")
+        self.assertAlmostEqual(float(self.getEOSBalance(self.FEEACCT)) - feeBeforeBal, 0.45)
+
+    def test_update_action_counts_profile_stats_through_activation_votes_and_settlement(self):
+        SCENARIO("test_update_action_counts_profile_stats_through_activation_votes_and_settlement")
+        def stats(userId):
+            rows = HOST.table("profstats", HOST, lower=userId, key_type="name", limit=1).json["rows"]
+            if len(rows) == 0 or rows[0]["id"] != userId:
+                return None
+            return (rows[0]["entries"], rows[0]["votesReceived"], rows[0]["contestsWon"])
+
+        # a second level like the first so votebatch reaches two contests
+        levelId = self.randomEOSIOId()
+        HOST.push_action(
+            "createlevel",
+            [{
+                "id":levelId,
+                "name":"Silver",
+                "categoryId": "music",
+                "price": 1000,
+                "participantLimit": 4,
+                "submissionPeriod": 4,
+                "votePeriod": 4,
+                "fee": 45, # = 4.5%
+                "prizes": [70, 30],
+                "fixedPrize": 0,
+                "allowedSimultaneousContests": 0,
+                "voteStartUTCHour": 0,
+            }],
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        entryIdB = self.randomEOSIOId()
+        entryIdB2 = self.randomEOSIOId()
+        for (entryId, userId, ACCT) in [(entryIdB, self.userId, self.ALICE), (entryIdB2, self.userId2, self.BOB)]:
+            HOST.push_action(
+                "entercontest",
+                [{
+                    "id": entryId,
+                    "userId": userId,
+                    "levelId": levelId,
+                    "videoHash720p": self.randomVideoHash(),
+                    "videoHash1080p": self.videoHash1080p,
+                    "coverHash": self.coverHash,
+                }],
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        # unpaid entries aren't counted
+        self.assertEqual([stats(userId) for userId in [self.userId, self.userId2, self.userId3]], [None, None, None])
+
+        HOST.push_action(
+            "addcurhigh",
+            {
+                "openTime": int(time.time()),
+                "usdHigh": 50000, # $5.0000
+                "intervalSec": 2, # 2 seconds
+            },
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        payments = [
+            (self.ALICE, self.entryId), (self.BOB, self.entryId2), (self.CAROL, self.entryId3),
+            (self.ALICE, entryIdB), (self.BOB, entryIdB2),
+        ]
+        for (ACCT, entryId) in payments:
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ACCT,
+                    "to": HOST,
+                    "quantity": "2.0000 EOS",
+                    "memo": entryId,
+                },
+                force_unique=True,
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        # activation counts the entry
+        self.assertEqual(stats(self.userId), (2, 0, 0))
+        self.assertEqual(stats(self.userId2), (2, 0, 0))
+        self.assertEqual(stats(self.userId3), (1, 0, 0))
+
+        time.sleep(5)
+
+        HOST.push_action(
+            "vote",
+            {
+                "entryId": self.entryId2,
+                "voterUserId": self.userId3,
+            },
+            permission=(self.CAROL, Permission.ACTIVE)
+        )
+
+        self.assertEqual(stats(self.userId), (2, 0, 0))
+        self.assertEqual(stats(self.userId2), (2, 1, 0))
+
+        # each vote of a batch is counted for the entry's owner
+        for (ACCT, voterUserId, entryIds) in [
+            (self.ALICE, self.userId, [self.entryId2, entryIdB2]),
+            (self.BOB, self.userId2, [self.entryId, entryIdB]),
+        ]:
+            HOST.push_action(
+                "votebatch",
+                {
+                    "voterUserId": voterUserId,
+                    "entryIds": entryIds,
+                },
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        HOST.push_action(
+            "vote",
+            {
+                "entryId": entryIdB2,
+                "voterUserId": self.userId3,
+            },
+            permission=(self.CAROL, Permission.ACTIVE)
+        )
+
+        self.assertEqual(stats(self.userId), (2, 2, 0))
+        self.assertEqual(stats(self.userId2), (2, 4, 0))
+        self.assertEqual(stats(self.userId3), (1, 0, 0))
+
+        time.sleep(4)
+
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+
+        # both contests pay two prizes: bob's entries rank first, alice's second & carol's third gets nothing
+        self.assertEqual(stats(self.userId), (2, 2, 2))
+        self.assertEqual(stats(self.userId2), (2, 4, 2))
+        self.assertEqual(stats(self.userId3), (1, 0, 0))
+
+        # a second update settles nothing more
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+        self.assertEqual(stats(self.userId), (2, 2, 2))
+        self.assertEqual(stats(self.userId2), (2, 4, 2))
+
     def test_update_action_sends_winnings_to_winner_and_flair_only_once(self):
         SCENARIO("test_update_action_sends_winnings_to_winner_and_flair_only_once")
         TOKENHOST.push_action(
@@ -414,22 +669,36 @@ class UpdateActionsUnitTest(unittest.TestCase):
         time.sleep(4)
         
         feeBeforeBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
-        HOST.table("contests", HOST)
+        HOST.table("contests", "music")
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         feeAfterBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         
         self.assertAlmostEqual(feeAfterBal - feeBeforeBal, 0.27)
         self.assertAlmostEqual(aliceAfterBal - aliceBeforeBal, 1.719)
         self.assertAlmostEqual(bobAfterBal - bobBeforeBal, 4.011)
 
+        contestId = HOST.table("entries", "music", lower=self.entryId2, key_type="name").json["rows"][0]["contestId"]
+        result = HOST.table("results", HOST, lower=contestId).json["rows"][0]
+        self.assertEqual(result["id"], contestId)
+        self.assertEqual(result["prizePool"], "6.0000 EOS")
+        self.assertEqual(result["fee"], "0.2700 EOS")
+        self.assertEqual(result["totalVotes"], 3)
+        self.assertEqual(len(result["winners"]), 2)
+        self.assertEqual(result["winners"][0]["entryId"], self.entryId2)
+        self.assertEqual(result["winners"][0]["prize"], "4.0110 EOS")
+
+        # votes are pruned once the contest is paid
+        votes = HOST.table("votes", "music").json["rows"]
+        self.assertEqual(len([v for v in votes if v["contestId"] == contestId]), 0)
+
     def test_update_action_sends_winnings_to_winners_when_tied_and_flair_only_once(self):
         SCENARIO("test_update_action_sends_winnings_to_winners_when_tied_and_flair_only_once")
         TOKENHOST.push_action(
@@ -479,17 +748,17 @@ class UpdateActionsUnitTest(unittest.TestCase):
         time.sleep(4)
         
         feeBeforeBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
-        HOST.table("contests", HOST)
+        HOST.table("contests", "music")
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         feeAfterBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         
         self.assertAlmostEqual(bobAfterBal - bobBeforeBal, 1.91)
         self.assertAlmostEqual(aliceAfterBal - aliceBeforeBal, 1.91)
@@ -533,15 +802,15 @@ class UpdateActionsUnitTest(unittest.TestCase):
         )
         
         feeBeforeBal = float(self.getEOSBalance(self.FEEACCT))
-        bobBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
-        HOST.table("contests", HOST)
+        HOST.table("contests", "music")
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         feeAfterBal = float(self.getEOSBalance(self.FEEACCT))
-        bobAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
         
         self.assertAlmostEqual(feeAfterBal, feeBeforeBal)
         self.assertAlmostEqual(bobAfterBal, bobBeforeBal)
@@ -592,7 +861,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
         )
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
-        entriesRes = HOST.table("entries", HOST, lower=self.entryId, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=self.entryId, key_type="name")
         print(entriesRes)
         entry = entriesRes.json["rows"][0]
         self.assertEqual(entry["id"], self.entryId)
@@ -638,33 +907,163 @@ class UpdateActionsUnitTest(unittest.TestCase):
             permission=(self.BOB, Permission.ACTIVE)
         )
 
-        HOST.table("contests", HOST)
-        HOST.table("entries", HOST)
+        HOST.table("contests", "music")
+        HOST.table("entries", "music")
 
         time.sleep(5)
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE)) 
-        HOST.table("contests", HOST)
-        HOST.table("entries", HOST)
+        HOST.table("contests", "music")
+        HOST.table("entries", "music")
 
-        entriesRes = HOST.table("entries", HOST, lower=self.entryId, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=self.entryId, key_type="name")
         try:
             self.assertNotEqual(entriesRes.json["rows"][0]['id'], self.entryId)
         except IndexError:
             pass
 
-        entriesRes = HOST.table("entries", HOST, lower=self.entryId2, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=self.entryId2, key_type="name")
         try:
             self.assertNotEqual(entriesRes.json["rows"][0]['id'], self.entryId2)
         except IndexError:
             pass
 
-        entriesRes = HOST.table("entries", HOST, lower=self.entryId3, key_type="name")
+        entriesRes = HOST.table("entries", "music", lower=self.entryId3, key_type="name")
         try:
             self.assertNotEqual(entriesRes.json["rows"][0]['id'], self.entryId3)
         except IndexError:
             pass
 
+    def test_update_action_archives_within_budget_and_resumes(self):
+        SCENARIO("test_update_action_archives_within_budget_and_resumes")
+        # a category of its own, archived ahead of music so rows left by other tests take none of the budget
+        HOST.push_action(
+            "createcat", 
+            {
+                "id":"archive",
+                "name":"Archive",
+                "maxVideoLength": 30,
+            }, 
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        levelId = self.randomEOSIOId()
+        HOST.push_action(
+            "createlevel", 
+            [{
+                "id":levelId,
+                "name":"Gold",
+                "categoryId": "archive",
+                "price": 1000,
+                "participantLimit": 4,
+                "submissionPeriod": 4,
+                "votePeriod": 4,
+                "fee": 45, # = 4.5%
+                "prizes": [70, 30],
+                "fixedPrize": 0,
+                "allowedSimultaneousContests": 0,
+                "voteStartUTCHour": 0,
+            }], 
+            permission=(HOST, Permission.ACTIVE)
+        )
+
+        HOST.push_action(
+            "setentryarch",
+            [1],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        # each call scans the ended contest once & has room left for a single entry
+        HOST.push_action(
+            "setarchbudg",
+            [ARCHIVE_COST_SCAN + ARCHIVE_COST_ENTRY],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        # a fresh price so the payments activate right away
+        HOST.push_action(
+            "addcurhigh",
+            {
+                "openTime": int(time.time()),
+                "usdHigh": 50000, # $5.0000
+                "intervalSec": 2, # 2 seconds
+            },
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        entryIds = []
+        for (userId, ACCT) in [(self.userId, self.ALICE), (self.userId2, self.BOB)]:
+            entryId = self.randomEOSIOId()
+            entryIds.append(entryId)
+            HOST.push_action(
+                "entercontest",
+                [{
+                    "id": entryId,
+                    "userId": userId,
+                    "levelId": levelId,
+                    "videoHash720p": self.randomVideoHash(),
+                    "videoHash1080p": self.videoHash1080p,
+                    "coverHash": self.coverHash,
+                }],
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+            TOKENHOST.push_action(
+                "transfer",
+                {
+                    "from": ACCT,
+                    "to": HOST,
+                    "quantity": "2.0000 EOS", 
+                    "memo": entryId,
+                },
+                force_unique=True,
+                permission=(ACCT, Permission.ACTIVE)
+            )
+
+        entries = HOST.table("entries", "archive").json["rows"]
+        self.assertEqual(sorted(row["id"] for row in entries), sorted(entryIds))
+        self.assertEqual(entries[0]["contestId"], entries[1]["contestId"])
+
+        # past the vote period & the archive delay
+        time.sleep(12)
+
+        # settles the contest, then archives the first entry
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+        self.assertEqual(len(HOST.table("entries", "archive").json["rows"]), 1)
+        self.assertEqual(len(HOST.table("contests", "archive").json["rows"]), 1)
+
+        # cursors at 0 have no row, no entry is past the archive window yet
+        cursors = {row["id"] for row in HOST.table("archcursors", "archive").json["rows"]}
+        self.assertIn("votes", cursors)
+        self.assertIn("contests", cursors)
+        self.assertNotIn("entries", cursors)
+
+        # resumes at the same contest for the second entry, nothing left for the contest row
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+        self.assertEqual(len(HOST.table("entries", "archive").json["rows"]), 0)
+        self.assertEqual(len(HOST.table("contests", "archive").json["rows"]), 1)
+
+        HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
+        self.assertEqual(len(HOST.table("entries", "archive").json["rows"]), 0)
+        self.assertEqual(len(HOST.table("contests", "archive").json["rows"]), 0)
+
+        HOST.push_action(
+            "setarchbudg",
+            [0],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
+        HOST.push_action(
+            "setentryarch",
+            [50],
+            permission=(HOST, Permission.ACTIVE),
+            force_unique=1
+        )
+
     def test_update_action_sends_fixed_prize_winnings_to_winner_and_flair_only_once(self):
         return
         SCENARIO("test_update_action_sends_winnings_to_winner_and_flair_only_once")
@@ -691,7 +1090,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId2,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -708,7 +1107,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId2,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -724,7 +1123,7 @@ class UpdateActionsUnitTest(unittest.TestCase):
                 "levelId": self.levelId2,
                 "videoHash360p": self.videoHash360p,
                 "videoHash480p": self.videoHash480p,
-                "videoHash720p": self.videoHash720p,
+                "videoHash720p": self.randomVideoHash(),
                 "videoHash1080p": self.videoHash1080p,
                 "coverHash": self.coverHash,
             }],
@@ -774,18 +1173,18 @@ class UpdateActionsUnitTest(unittest.TestCase):
         )
         
         feeBeforeBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobBeforeBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobBeforeBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
 
-        HOST.table("contests", HOST)
+        HOST.table("contests", "music")
 
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
         HOST.push_action("update", force_unique=True, permission=(HOST, Permission.ACTIVE))
 
         feeAfterBal = float(self.getEOSBalance(self.FEEACCT))
-        aliceAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId, key_type="name").json["rows"])
-        bobAfterBal = extract_profile_winnings(HOST.table("profiles", HOST, lower=self.userId2, key_type="name").json["rows"])
+        aliceAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId, key_type="name").json["rows"])
+        bobAfterBal = extract_profile_winnings(HOST.table("balances", HOST, lower=self.userId2, key_type="name").json["rows"])
 
         
         self.assertAlmostEqual(feeAfterBal - feeBeforeBal, 0.0)
@@ -0,0 +1,129 @@
+"""
+WASM size budget - reports the size & function count of built contracts and fails when one grows past its
+recorded budget, so code size only goes up on purpose.
+
+    eosio-cpp src/flair.cpp -o flair.wasm
+    python3 tests/wasm_size.py flair.wasm             # report & check against wasm_budget.json
+    python3 tests/wasm_size.py --update flair.wasm    # record the current sizes as the budget
+"""
+import json, os, sys
+
+BUDGET_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "wasm_budget.json")
+
+# growth allowed over the recorded budget before the check fails
+TOLERANCE = 0.01
+
+SECTION_IMPORT = 2
+SECTION_FUNCTION = 3
+SECTION_CODE = 10
+
+def read_leb128(data, pos):
+    result = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7f) << shift
+        shift += 7
+        if byte & 0x80 == 0:
+            return result, pos
+
+def read_name(data, pos):
+    length, pos = read_leb128(data, pos)
+    return data[pos:pos + length], pos + length
+
+def count_imported_functions(data, pos):
+    count, pos = read_leb128(data, pos)
+    functions = 0
+    for _ in range(count):
+        _, pos = read_name(data, pos)
+        _, pos = read_name(data, pos)
+        kind = data[pos]
+        pos += 1
+        if kind == 0:    # function: type index
+            _, pos = read_leb128(data, pos)
+            functions += 1
+        elif kind == 1:  # table: element type & limits
+            pos += 1
+            flags, pos = read_leb128(data, pos)
+            _, pos = read_leb128(data, pos)
+            if flags & 1:
+                _, pos = read_leb128(data, pos)
+        elif kind == 2:  # memory: limits
+            flags, pos = read_leb128(data, pos)
+            _, pos = read_leb128(data, pos)
+            if flags & 1:
+                _, pos = read_leb128(data, pos)
+        elif kind == 3:  # global: value type & mutability
+            pos += 2
+    return functions
+
+def measure(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\0asm":
+        raise ValueError(path + " is not a wasm module")
+
+    report = {"bytes": len(data), "functions": 0, "imports": 0, "codeBytes": 0}
+    pos = 8
+    while pos < len(data):
+        section_id = data[pos]
+        size, pos = read_leb128(data, pos + 1)
+        if section_id == SECTION_IMPORT:
+            report["imports"] = count_imported_functions(data, pos)
+        elif section_id == SECTION_FUNCTION:
+            report["functions"], _ = read_leb128(data, pos)
+        elif section_id == SECTION_CODE:
+            report["codeBytes"] = size
+        pos += size
+    return report
+
+def main(args):
+    update = "--update" in args
+    paths = [arg for arg in args if arg != "--update"]
+    if len(paths) == 0:
+        print(__doc__.strip())
+        return 2
+
+    budget = {}
+    if os.path.exists(BUDGET_FILE):
+        with open(BUDGET_FILE) as f:
+            budget = json.load(f)
+    elif not update:
+        print("no budget file at " + BUDGET_FILE + ", run with --update")
+        return 1
+
+    failed = False
+    for path in paths:
+        contract = os.path.basename(path)
+        report = measure(path)
+        print("%s: %d bytes, %d functions (%d imported), code section %d bytes" % (
+            contract, report["bytes"], report["functions"], report["imports"], report["codeBytes"]))
+
+        if update:
+            budget[contract] = {"bytes": report["bytes"], "functions": report["functions"]}
+            continue
+
+        if budget.get(contract) is None:
+            print("  no budget recorded, run with --update")
+            failed = True
+            continue
+
+        for key in ("bytes", "functions"):
+            limit = budget[contract][key]
+            if report[key] > limit * (1 + TOLERANCE):
+                print("  over budget: %s %d > %d" % (key, report[key], limit))
+                failed = True
+            else:
+                print("  %s %+d against budget %d" % (key, report[key] - limit, limit))
+
+    if update:
+        with open(BUDGET_FILE, "w") as f:
+            json.dump(budget, f, indent=4, sort_keys=True)
+            f.write("\n")
+        print("budget written to " + BUDGET_FILE)
+
+    return 1 if failed else 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))